@@ -1,24 +1,112 @@
 #include "Eigenvalue calculation.h"
 #include <string.h>
+#include <stdlib.h>
+#include "arm_const_structs.h"
+#if ALGO_FIXED_POINT
+#include "arm_common_tables.h"
+#endif
 
-#define MIN_VALID_PEAK_AMP  0.04f
+// 峰值门限: 峰值须高于所在频带噪声底 NF_SNR_RATIO 倍，且不低于 NF_ABS_MIN_AMP
+#define NF_BAND_BINS        256       // 噪声底分带宽度 (bin)
+#define NF_PERCENTILE       50        // 取频带内幅值的分位数 (中位数)
+#define NF_SNR_RATIO        3.98f     // 12 dB；瑞利分布噪声下单 bin 误报率约 2e-5
+#define NF_ABS_MIN_AMP      0.002f    // 约 1 LSB，静置时不上报量化噪声
 
+#if ALGO_FIXED_POINT
+static q15_t fftBufQ[FFT_POINTS] __ALIGNED(4);   // Z 轴 q15 输入 / 原位复数频谱，位移逆变换时作 N/4 点 float 复数谱 (8KB)
+static arm_rfft_fast_instance_f32 S_dispRfft;      // 位移逆变换 (N/2 点实 FFT)
+#else
 static arm_rfft_fast_instance_f32 S_rfft;
 static float32_t fftBuf[FFT_POINTS]; 
+static float32_t magBuf[FFT_POINTS / 2];   // 单边幅值谱 (g)，fftBuf 保留复数谱供频域积分
+static float32_t s_NoiseFloorZ[FFT_POINTS / 2 / NF_BAND_BINS];   // Z 轴各频带噪声底 (g)
+
+// 包络谱: 带通 (HP + LP 两级 biquad) -> 整流 -> 抽取 -> 小点数 RFFT
+static arm_rfft_fast_instance_f32 S_envRfft;
+static arm_biquad_cascade_df2T_instance_f32 S_envBp;
+static float32_t envBpCoeffs[5 * 2];
+static float32_t envBpState[2 * 2];
+static float32_t envBlk[ENV_BLOCK];
+static float32_t envBuf[ENV_FFT_POINTS];
+static uint16_t  s_envFs = 0;              // 当前系数对应的采样率，0 = 未设计
+static uint8_t   s_envValid = 0;           // 采样率太低放不下通带时为 0
+
+#endif
+
+// 当前帧使用的窗 (g_cfg_window)，Process_Data 开始时取一次
+static const WinInfo_t *s_Win = &g_WinInfo[WIN_DEFAULT];
+
+#if (WIN_TABLE_LEN % FFT_POINTS) != 0
+#error "FFT_POINTS must divide WIN_TABLE_LEN"
+#endif
 AxisFeatureValue X_data,Y_data,Z_data;
 //static float g_WaveZ_Live[FFT_POINTS]; 
-static float g_WaveZ_Tx[FFT_POINTS];
+static int16_t g_WaveZ_Tx[FFT_POINTS];     // Z 轴原始采样快照 (LSB)，发送时按所选编码转换
+static float   g_WaveZ_Mean = 0.0f;       // 快照直流分量 (LSB)
 volatile uint8_t g_SnapshotReq = 0;       
+static uint16_t s_CalcFs = 0;             // 当前帧的采样率，AlgoTask 按帧标记设置 (Calc_SetFrameConfig)
+static uint8_t  s_CalcFlags = 0;          // 当前帧的 ACQ_FLAG_xxx
+static SpecPeak_t s_PeakTable[PEAK_TABLE_N];   // 最近一帧峰值表 (按幅值降序)
+static uint8_t    s_PeakCount = 0;
 
 float g_z_offset_g  = 0.0f;   // 0g 偏移
 
 //extern const arm_cfft_instance_f32 arm_cfft_sR_f32_len1024;
 //#define CFFT (&arm_cfft_sR_f32_len1024)
 
+#if ALGO_FFT_BENCH && !ALGO_FIXED_POINT
+static void Calc_BenchFFT(void);
+#endif
+#if ALGO_NF_BENCH
+static void Calc_BenchNoiseFloor(void);
+#endif
+#if ALGO_WELCH_PSD
+static void Welch_Init(void);
+#endif
+#if !ALGO_FIXED_POINT
+static void Env_Design(uint16_t fs);
+#endif
+
 //计算初始化函数
 void Calc_Init(void)
 {
+#if ALGO_FIXED_POINT
+    arm_rfft_fast_init_f32(&S_dispRfft, FFT_POINTS / 2);
+#else
     arm_rfft_fast_init_f32(&S_rfft, FFT_POINTS);
+    arm_rfft_fast_init_f32(&S_envRfft, ENV_FFT_POINTS);
+    arm_biquad_cascade_df2T_init_f32(&S_envBp, 2, envBpCoeffs, envBpState);
+#endif
+
+    s_CalcFs = g_cfg_freq_hz;
+
+    // DWT 周期计数器，用于统计 Process_Data 耗时
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+#if ALGO_WELCH_PSD
+    Welch_Init();
+#endif
+
+#if ALGO_FFT_BENCH && !ALGO_FIXED_POINT
+    Calc_BenchFFT();
+#endif
+#if ALGO_NF_BENCH
+    Calc_BenchNoiseFloor();
+#endif
+}
+
+// 帧的采样率与上一帧不同 (ODR 切换后的第一帧) 时，按新采样率重新设计滤波器。
+// 帧按自己的采样率与 ADP 标记处理，与 g_cfg_freq_hz / g_cfg_adp 何时改变无关
+void Calc_SetFrameConfig(uint16_t fs, uint8_t flags)
+{
+    s_CalcFlags = flags;
+    if (fs == s_CalcFs) return;
+    s_CalcFs = fs;
+#if !ALGO_FIXED_POINT
+    Env_Design(fs);
+#endif
 }
 
 void Create_Wave_Snapshot(void)
@@ -30,11 +118,24 @@ void Create_Wave_Snapshot(void)
     g_SnapshotReq = 1;
 }
 
-const float* Algo_Get_Snapshot_Ptr(void)
+const int16_t* Algo_Get_Snapshot_Ptr(float *mean_lsb)
 {
+    *mean_lsb = g_WaveZ_Mean;
     return g_WaveZ_Tx;
 }
 
+uint8_t Algo_Get_PeakTable(SpecPeak_t *out)
+{
+    taskENTER_CRITICAL();
+    uint8_t n = s_PeakCount;
+    memcpy(out, s_PeakTable, sizeof(s_PeakTable));
+    taskEXIT_CRITICAL();
+#if ALGO_FIXED_POINT
+    n = PEAK_COUNT_NA;
+#endif
+    return n;
+}
+
 void Z_Calib_Z_Upright_Neg1G(float *gBuf, uint32_t N)
 {
     float sum_g = 0.0f;
@@ -67,187 +168,1540 @@ static inline CFFT_PTR_T pick_cfft_u32(uint32_t N)
     }
 }*/
 
-static void Remove_DC(float *data, uint32_t len)
+// 重力加速度常数: 1g ≈ 9806.65 mm/s²
+#define G_TO_MM_S2  9806.65f
+
+volatile uint32_t g_AlgoCycles    = 0;   // 最近一帧 Process_Data 耗时 (DWT 周期)
+volatile uint32_t g_AlgoCyclesMax = 0;   // 历史最大耗时
+
+// 单轴原始平面 (RAW_AXIS) 的整数和，结果精确
+static int32_t Raw_Sum(const int16_t *pAxis, uint32_t len)
 {
-    float sum = 0.0f;
-    
-    // 1. 计算均值
-    for (uint32_t i = 0; i < len; i++) {
-        sum += data[i];
+    int32_t sum = 0;
+    uint32_t i = 0;
+#if defined(ARM_MATH_DSP)
+    // 平面连续: 一次读两个采样，__SMLAD 各乘 1 后累加
+    for (; i + 2 <= len; i += 2) {
+        sum = (int32_t)__SMLAD((uint32_t)read_q15x2(&pAxis[i]), 0x00010001u, (uint32_t)sum);
     }
-    float mean = sum / (float)len;
+#endif
+    for (; i < len; i++) sum += pAxis[i];
+    return sum;
+}
 
-    // 2. 减去均值
-    for (uint32_t i = 0; i < len; i++) {
-        data[i] -= mean;
+/* ================== 自适应噪声底 ==================
+ * 固定门限只对调试时的 ODR 和安装方式有效。这里每帧把幅值谱按 NF_BAND_BINS 分带，
+ * 用快速选择 (平均 O(n)) 求每带中位数作为噪声底，峰值按 SNR 判定。
+ * 分带只需 NF_BAND_BINS 个 float 的拷贝缓冲 (1KB)，中位数对少量强谱线不敏感。 */
+static float32_t nfScratch[NF_BAND_BINS];
+
+// 快速选择 (Hoare 划分 + 三数取中)，返回 a[0..n) 中第 k 小的值，a 会被打乱
+static float32_t Select_Kth(float32_t *a, uint32_t n, uint32_t k)
+{
+    int32_t lo = 0, hi = (int32_t)n - 1;
+
+    while (lo < hi) {
+        int32_t mid = lo + (hi - lo) / 2;
+        float32_t x = a[lo], y = a[mid], z = a[hi];
+        float32_t pivot = (x < y) ? ((y < z) ? y : ((x < z) ? z : x))
+                                  : ((x < z) ? x : ((y < z) ? z : y));
+        int32_t i = lo, j = hi;
+        while (i <= j) {
+            while (a[i] < pivot) i++;
+            while (a[j] > pivot) j--;
+            if (i <= j) {
+                float32_t t = a[i]; a[i] = a[j]; a[j] = t;
+                i++;
+                j--;
+            }
+        }
+        if ((int32_t)k <= j) hi = j;
+        else if ((int32_t)k >= i) lo = i;
+        else break;
     }
+    return a[k];
 }
 
-//时域特征计算 (Mean, RMS, PP, Kurt)
-static void Calc_TimeDomain_Only(float32_t *data, uint32_t len, AxisFeatureValue *result)
+#if !ALGO_FIXED_POINT || ALGO_NF_BENCH
+// 按频带估计噪声底: floor[b] = mag[b*NF_BAND_BINS ...] 的分位数 (stride 用于交错存放的幅值)
+static void NoiseFloor_Estimate(const float32_t *mag, uint32_t stride, uint32_t bins, float32_t *floor)
 {
-    float32_t sum = 0.0f;
-    float32_t sumSq = 0.0f;
-    float32_t minVal = data[0];
-    float32_t maxVal = data[0];
-    float32_t mean, rms, pp, kurt;
+    for (uint32_t b = 0; b * NF_BAND_BINS < bins; b++) {
+        uint32_t start = b * NF_BAND_BINS;
+        uint32_t n = (bins - start < NF_BAND_BINS) ? (bins - start) : NF_BAND_BINS;
+        for (uint32_t i = 0; i < n; i++) nfScratch[i] = mag[(start + i) * stride];
+        floor[b] = Select_Kth(nfScratch, n, n * NF_PERCENTILE / 100);
+    }
+}
+#endif
 
-    for (uint32_t i = 0; i < len; i++) {
-        float32_t val = data[i];
-        sum += val;
-        sumSq += val * val;
-        if (val < minVal) minVal = val;
-        if (val > maxVal) maxVal = val;
+// bin 所在频带的峰值门限 (scale 把 floor 的单位换算为 g)
+static float32_t NoiseFloor_Gate(const float32_t *floor, uint32_t bin, float32_t scale)
+{
+    float32_t gate = floor[bin / NF_BAND_BINS] * scale * NF_SNR_RATIO;
+    return (gate > NF_ABS_MIN_AMP) ? gate : NF_ABS_MIN_AMP;
+}
+
+#if ALGO_NF_BENCH
+volatile uint32_t g_NfBenchCycles[2];   // [0] 快速选择求各带中位数，[1] 各带整段排序后取中位数
+
+static int Cmp_F32(const void *a, const void *b)
+{
+    float32_t x = *(const float32_t *)a, y = *(const float32_t *)b;
+    return (x > y) - (x < y);
+}
+
+// 上电跑一次，输入为 LCG 伪随机幅值，结果在调试器里看 g_NfBenchCycles
+static void Calc_BenchNoiseFloor(void)
+{
+    static float32_t src[FFT_POINTS / 2];
+    float32_t floor[FFT_POINTS / 2 / NF_BAND_BINS];
+    uint32_t seed = 12345u, t0;
+
+    for (uint32_t i = 0; i < FFT_POINTS / 2; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        src[i] = (float32_t)(seed >> 8) * (1.0f / 16777216.0f);
     }
-    mean = sum / (float32_t)len;
-    rms = sqrtf(sumSq / (float32_t)len); // 这里是包含直流分量的 RMS
-    pp = maxVal - minVal;
 
-    // 第二遍循环：计算峭度 (Kurtosis) 需要中心矩
-    // Kurtosis = E[(x - u)^4] / (sigma^4)
-    float32_t m2 = 0.0f; // 二阶中心矩 (方差 * N)
-    float32_t m4 = 0.0f; // 四阶中心矩
+    t0 = DWT->CYCCNT;
+    NoiseFloor_Estimate(src, 1, FFT_POINTS / 2, floor);
+    g_NfBenchCycles[0] = DWT->CYCCNT - t0;
 
+    t0 = DWT->CYCCNT;
+    for (uint32_t b = 0; b < FFT_POINTS / 2 / NF_BAND_BINS; b++) {
+        memcpy(nfScratch, &src[b * NF_BAND_BINS], sizeof(nfScratch));
+        qsort(nfScratch, NF_BAND_BINS, sizeof(float32_t), Cmp_F32);
+        floor[b] = nfScratch[NF_BAND_BINS * NF_PERCENTILE / 100];
+    }
+    g_NfBenchCycles[1] = DWT->CYCCNT - t0;
+}
+#endif
+
+#if !ALGO_FIXED_POINT
+/* ================== 单遍多轴特征流水线 ==================
+ * 原流程对每个轴独立地 "转换 -> 时域 -> 去直流 -> 积分 -> RMS"，
+ * Z 轴还要为频谱/速度/包络把原始数据重新读取转换 4 次，同一份 fftBuf 反复求均值。
+ * 现按阶段组织，中间量(均值/去直流信号/积分状态)缓存在 AxisStage_t：
+ *   Stage 1: 整数和 + arm_min_q15/arm_max_q15 (原始 q15 平面上的向量运算) -> mean, pp
+ *   Stage 2: 去直流信号 d = x - mean，累加中心矩/速度积分/包络，Z 轴 d 直接写入 fftBuf (FFT 输入)
+ *   Stage 3: 用缓存的速度均值重放积分，得到去均值后的速度 RMS
+ * 原始帧按轴分平面存放，各阶段逐轴顺序读取。Stage 1 的和改为整数累加，因 x/512 的部分和
+ * 在 float 中本来就精确，X/Y/Z_data 结果与交错布局逐位相同。
+ */
+
+// 单轴原始平面 -> 去直流加速度 (g)。M4 的 FPU 转换是标量的，一遍融合循环比
+// arm_q15_to_float + arm_scale_f32 + arm_offset_f32 三遍读写更省
+static void Raw_ToG(const int16_t *pAxis, float32_t *out, uint32_t len, float32_t mean)
+{
     for (uint32_t i = 0; i < len; i++) {
-        float32_t diff = data[i] - mean;
-        float32_t diff2 = diff * diff;
-        m2 += diff2;
-        m4 += diff2 * diff2;
+        out[i] = (float32_t)pAxis[i] * KX134_SENSITIVITY - mean;
+    }
+}
+
+typedef struct
+{
+    float32_t sum;        // Stage 1: 加速度累加
+    float32_t minVal;
+    float32_t maxVal;
+    float32_t mean;       // 缓存的直流分量 (供 Stage 2/3 复用)
+
+    float32_t m2;         // Stage 2: 二阶中心矩 (流式模式下来自 DataTask 累加)
+    float32_t m4;         // Stage 2: 四阶中心矩
+    float32_t velSum;     // 速度累加 (求速度均值)
+    float32_t velMean;
+    float32_t velSumSq;   // Stage 3: 去均值速度平方和
+
+    float32_t envSumSq;   // 包络: |d| 平方和
+    float32_t envMax;     // 包络: |d| 最大值
+} AxisStage_t;
+
+static AxisStage_t s_Stage[AXIS_COUNT];
+
+// Stage 1: 一阶统计 (各轴平面连续，最值用 CMSIS 向量函数)
+static void Stage_Convert(const int16_t *pRawData, uint32_t len)
+{
+    for (uint32_t k = 0; k < AXIS_COUNT; k++) {
+        const int16_t *pAxis = RAW_AXIS(pRawData, k);
+        AxisStage_t *st = &s_Stage[k];
+        q15_t minRaw, maxRaw;
+        uint32_t idx;
+
+        arm_min_q15(pAxis, len, &minRaw, &idx);
+        arm_max_q15(pAxis, len, &maxRaw, &idx);
+        st->sum    = (float32_t)Raw_Sum(pAxis, len) * KX134_SENSITIVITY;
+        st->minVal = (float32_t)minRaw * KX134_SENSITIVITY;
+        st->maxVal = (float32_t)maxRaw * KX134_SENSITIVITY;
+        st->mean   = st->sum / (float32_t)len;
+    }
+}
+
+// Stage 1 (流式模式): 均值/峰峰值/中心矩已在 DataTask 中逐块累加完成，这里只取结果
+static void Stage_FromStream(const StreamAxisAcc_t *pStream)
+{
+    for (uint32_t k = 0; k < AXIS_COUNT; k++) {
+        AxisStage_t *st = &s_Stage[k];
+        st->sum    = pStream[k].sum;
+        st->minVal = pStream[k].minVal;
+        st->maxVal = pStream[k].maxVal;
+        st->mean   = pStream[k].mean;
+        st->m2     = pStream[k].M2;
+        st->m4     = pStream[k].M4;
     }
-    if (m2 < 1e-9f) {
+}
+
+// Stage 2: 去直流 -> 中心矩 / 梯形积分 / 整流包络，Z 轴同时生成加窗后的 FFT 输入 (逐轴)
+// calcMoments = 0 时中心矩已由流式累加给出，跳过
+static void Stage_Centered(const int16_t *pRawData, uint32_t len, float32_t *zOut, uint8_t calcMoments)
+{
+    float dt = (s_CalcFs != 0) ? 1.0f / (float)s_CalcFs : 0.0f; // 采样间隔 (例如 1/25600)
+    float32_t envSumSq = 0.0f;
+    float32_t envMax = 0.0f;
+    uint32_t winStride = WIN_TABLE_LEN / len;
+
+    for (uint32_t k = 0; k < AXIS_COUNT; k++) {
+        const int16_t *pAxis = RAW_AXIS(pRawData, k);
+        AxisStage_t *st = &s_Stage[k];
+        const float32_t mean = st->mean;
+        float32_t m2 = 0.0f, m4 = 0.0f;
+        float32_t accPrev = (float)pAxis[0] * KX134_SENSITIVITY - mean;
+        float32_t vel = 0.0f, velSum = 0.0f;
+
+        for (uint32_t i = 0; i < len; i++) {
+            float32_t diff = (float)pAxis[i] * KX134_SENSITIVITY - mean;
+
+            // 峭度中心矩
+            if (calcMoments) {
+                float32_t diff2 = diff * diff;
+                m2 += diff2;
+                m4 += diff2 * diff2;
+            }
+
+            // 梯形积分公式: v = v + (a1 + a2) * dt / 2, 单位 g -> mm/s
+            vel += (accPrev + diff) * 0.5f * dt * G_TO_MM_S2;
+            accPrev = diff;
+            velSum += vel;
+
+            // Z 轴: 去直流信号加窗即 FFT 输入；整流包络用未加窗信号
+            if (k == 2) {
+                zOut[i] = diff * Win_Value(s_Win, i, winStride);
+                float32_t z = (diff < 0.0f) ? -diff : diff;
+                envSumSq += z * z;
+                if (z > envMax) envMax = z;
+            }
+        }
+
+        if (calcMoments) {
+            st->m2 = m2;
+            st->m4 = m4;
+        }
+        st->velSum = velSum;
+        st->velMean = velSum / (float)len;
+    }
+    s_Stage[2].envSumSq = envSumSq;
+    s_Stage[2].envMax = envMax;
+}
+
+// Stage 3: 重放积分，计算去均值后的速度 RMS (积分是确定性的，重放结果与缓存整段速度相同)
+static void Stage_Velocity(const int16_t *pRawData, uint32_t len)
+{
+    float dt = (s_CalcFs != 0) ? 1.0f / (float)s_CalcFs : 0.0f;
+
+    for (uint32_t k = 0; k < AXIS_COUNT; k++) {
+        const int16_t *pAxis = RAW_AXIS(pRawData, k);
+        const float32_t mean = s_Stage[k].mean;
+        const float32_t velMean = s_Stage[k].velMean;
+        float32_t accPrev = (float)pAxis[0] * KX134_SENSITIVITY - mean;
+        float32_t vel = 0.0f, velSumSq = 0.0f;
+
+        for (uint32_t i = 0; i < len; i++) {
+            float32_t diff = (float)pAxis[i] * KX134_SENSITIVITY - mean;
+            float32_t v;
+
+            if (s_CalcFs != 0) {
+                vel += (accPrev + diff) * 0.5f * dt * G_TO_MM_S2;
+                accPrev = diff;
+                v = vel - velMean;
+            } else {
+                v = diff;   // 无有效采样率时不积分，沿用去直流加速度
+            }
+            velSumSq += v * v;
+        }
+        s_Stage[k].velSumSq = velSumSq;
+    }
+}
+
+// 时域特征输出 (Mean, 速度RMS, PP, Kurt)
+static void Stage_Finalize(const AxisStage_t *st, uint32_t len, AxisFeatureValue *result)
+{
+    float32_t kurt;
+
+    // Kurtosis = E[(x - u)^4] / (sigma^4) = N * m4 / (m2^2)
+    if (st->m2 < 1e-9f) {
         kurt = 0.0f;
     } else {
-        // 公式调整：N * m4 / (m2^2)
-        kurt = ((float32_t)len * m4) / (m2 * m2);
+        kurt = ((float32_t)len * st->m4) / (st->m2 * st->m2);
     }
-    result->mean = mean;
-    result->rms  = rms;
-    result->pp   = pp;
+    result->mean = st->mean;
+    result->rms  = sqrtf(st->velSumSq / (float)len);   // 速度 RMS (mm/s)
+    result->pp   = st->maxVal - st->minVal;
     result->kurt = kurt;
 }
-//积分
-static void Integrate_Acc_To_Vel(float *data, uint32_t len)
+
+/* arm_rfft_fast_f32 的 split 阶段顺序写 pOut、倒序读 p，输入输出同址时 fs/4 以上的 bin 会读到
+ * 已被覆盖的数据。这里直接调用内部 cfft，再按 (k, L-k) 成对做 split / merge，可以安全原位。 */
+static void Rfft_Forward_InPlace(const arm_rfft_fast_instance_f32 *S, float32_t *data)
 {
-    if (g_cfg_freq_hz == 0) return;
-    float dt = 1.0f / (float)g_cfg_freq_hz; // 采样间隔 (例如 1/25600)
-    float vel = 0.0f;
-    float val_prev = data[0]; // 上一个点的加速度
-    
-    // 重力加速度常数: 1g ≈ 9806.65 mm/s²
-    const float G_TO_MM_S2 = 9806.65f; 
+    const float32_t *pCoeff = S->pTwiddleRFFT;
+    uint32_t L = S->Sint.fftLen;   // 复数点数 = N/2
 
-    for (uint32_t i = 0; i < len; i++) {
-        float val_curr = data[i];
-        
-        // 梯形积分公式: v = v + (a1 + a2) * dt / 2
-        // 转换单位: g -> mm/s
-        vel += (val_prev + val_curr) * 0.5f * dt * G_TO_MM_S2;
-        
-        val_prev = val_curr;
-        
-        // 原地覆盖：现在 data[i] 变成速度了 (mm/s)
-        data[i] = vel;
-    }
-
-    float sum = 0.0f;
-    for (uint32_t i = 0; i < len; i++) sum += data[i];
-    float mean = sum / (float)len;
+    arm_cfft_f32(&S->Sint, data, 0, 1);
 
-    for (uint32_t i = 0; i < len; i++) {
-        data[i] -= mean;
+    for (uint32_t k = 1; k <= L / 2; k++) {
+        uint32_t m = L - k;
+        float32_t aR = data[2 * k], aI = data[2 * k + 1];
+        float32_t bR = data[2 * m], bI = data[2 * m + 1];
+        float32_t twR = pCoeff[2 * k], twI = pCoeff[2 * k + 1];
+        float32_t t1a = bR - aR;
+        float32_t t1b = bI + aI;
+
+        data[2 * k]     = 0.5f * (aR + bR + twR * t1a + twI * t1b);
+        data[2 * k + 1] = 0.5f * (aI - bI + twI * t1a - twR * t1b);
+        if (m != k) {
+            twR = pCoeff[2 * m];
+            twI = pCoeff[2 * m + 1];
+            t1a = aR - bR;
+            data[2 * m]     = 0.5f * (bR + aR + twR * t1a + twI * t1b);
+            data[2 * m + 1] = 0.5f * (bI - aI + twI * t1a - twR * t1b);
+        }
     }
-    
+    float32_t x0 = data[0], x1 = data[1];
+    data[0] = x0 + x1;   // DC
+    data[1] = x0 - x1;   // Nyquist
 }
+#endif /* !ALGO_FIXED_POINT */
 
-static void Calc_RMS_Only(float *data, uint32_t len , AxisFeatureValue *result)
+static void Rfft_Inverse_InPlace(const arm_rfft_fast_instance_f32 *S, float32_t *data)
 {
-    float sumSq = 0.0f;
-    for (uint32_t i = 0; i < len; i++) {
-        sumSq += data[i] * data[i];
+    const float32_t *pCoeff = S->pTwiddleRFFT;
+    uint32_t L = S->Sint.fftLen;
+
+    float32_t x0 = data[0], x1 = data[1];
+    data[0] = 0.5f * (x0 + x1);
+    data[1] = 0.5f * (x0 - x1);
+
+    for (uint32_t k = 1; k <= L / 2; k++) {
+        uint32_t m = L - k;
+        float32_t aR = data[2 * k], aI = data[2 * k + 1];
+        float32_t bR = data[2 * m], bI = data[2 * m + 1];
+        float32_t twR = pCoeff[2 * k], twI = pCoeff[2 * k + 1];
+        float32_t t1a = aR - bR;
+        float32_t t1b = aI + bI;
+
+        data[2 * k]     = 0.5f * (aR + bR - twR * t1a - twI * t1b);
+        data[2 * k + 1] = 0.5f * (aI - bI + twI * t1a - twR * t1b);
+        if (m != k) {
+            twR = pCoeff[2 * m];
+            twI = pCoeff[2 * m + 1];
+            t1a = bR - aR;
+            data[2 * m]     = 0.5f * (bR + aR - twR * t1a - twI * t1b);
+            data[2 * m + 1] = 0.5f * (bI - aI + twI * t1a - twR * t1b);
+        }
     }
-    result->rms =  sqrtf(sumSq / (float)len);
+
+    arm_cfft_f32(&S->Sint, data, 1, 1);
 }
 
-//频域特征计算 (Z轴: PeakFreq, PeakAmp, 2xAmp)
+#if !ALGO_FIXED_POINT
+/* 频域积分 (ω 算术)，输入为 Rfft_Forward_InPlace 的复数谱 (加速度 g):
+ *   时域已加窗时直接使用；矩形窗时先在频域做 Hann 加窗 (三点卷积 0.5X[k] - 0.25X[k-1] - 0.25X[k+1])。
+ *   矩形窗旁瓣按 1/Δk 衰减，经 1/ω² 放大后会淹没低频 bin，非整周期信号位移误差可达数倍。
+ *   速度 RMS: Parseval，只累加 ISO 频带内的 bin，除以窗的能量增益 pg (Hann 为 0.375)
+ *   位移:     X_k * (-G / ω_k^2) * H_hp(f)，频带外置零，逆变换后取峰峰值 (中心处窗增益为 1)
+ * 执行后 data 内容为位移时域波形 (um，含窗)。 */
+static void Calc_FreqIntegrate_Z(float32_t *data, uint32_t len, AxisFeatureValue *result)
+{
+    if (s_CalcFs == 0) {
+        result->vel_rms_iso = 0.0f;
+        result->disp_pp = 0.0f;
+        return;
+    }
+
+    uint32_t half = len / 2;
+    float32_t freq_res = s_CalcFs / (float32_t)len;
+    float32_t w_res = 2.0f * PI * freq_res;
+    float32_t norm = 2.0f / (float32_t)len;
+    float32_t velSumSq = 0.0f;
+    uint8_t hannConv = (s_Win->half == NULL);
+    float32_t pg = hannConv ? g_WinInfo[WIN_HANN].pg : s_Win->pg;
+    // X[k-1] 加窗前的值。DC 取 Re(X[1]) 使加窗后直流为 0: 先去均值再加窗，
+    // 窗函数本身会在 bin1 留下 0.25*N*mean 的低频分量，再经 1/ω² 放大
+    float32_t prevR = data[2], prevI = 0.0f;
+
+    for (uint32_t k = 1; k < half; k++) {
+        float32_t curR = data[2 * k], curI = data[2 * k + 1];
+        float32_t xR = curR, xI = curI;
+        if (hannConv) {
+            float32_t nextR = (k + 1 < half) ? data[2 * k + 2] : data[1];   // k+1 = N/2 时为 Nyquist
+            float32_t nextI = (k + 1 < half) ? data[2 * k + 3] : 0.0f;
+            xR = 0.5f * curR - 0.25f * (prevR + nextR);
+            xI = 0.5f * curI - 0.25f * (prevI + nextI);
+            prevR = curR;
+            prevI = curI;
+        }
+
+        float32_t f = (float32_t)k * freq_res;
+        if (f > INTEG_BAND_HI_HZ) {
+            data[2 * k] = 0.0f;
+            data[2 * k + 1] = 0.0f;
+            continue;
+        }
+        float32_t w = (float32_t)k * w_res;
+        float32_t gv = norm * G_TO_MM_S2 / w;   // |X| -> 速度幅值 mm/s
+
+        if (f >= INTEG_BAND_LO_HZ) {
+            velSumSq += (xR * xR + xI * xI) * gv * gv;
+        }
+
+        float32_t r  = f / INTEG_HP_CORNER_HZ;
+        float32_t r2 = r * r;
+        float32_t hp = r2 / sqrtf(1.0f + r2 * r2);
+        float32_t gd = -hp * G_TO_MM_S2 * 1000.0f / (w * w);   // g -> um
+        data[2 * k]     = xR * gd;
+        data[2 * k + 1] = xI * gd;
+    }
+    data[0] = 0.0f;   // DC
+    data[1] = 0.0f;   // Nyquist
+    result->vel_rms_iso = sqrtf(0.5f * velSumSq / pg);
+
+    Rfft_Inverse_InPlace(&S_rfft, data);
+
+    float32_t dMin, dMax;
+    uint32_t idx;
+    arm_min_f32(data, len, &dMin, &idx);
+    arm_max_f32(data, len, &dMax, &idx);
+    result->disp_pp = dMax - dMin;
+}
+
+/* ================== 包络谱 ==================
+ * 带通 (二阶 Butterworth 高通 + 二阶低通，df2T) 取出轴承/齿轮冲击激起的高频共振带，
+ * 整流后按 ENV_DECIM 点求平均 (积分-清零，即一级 CIC) 完成低通 + 抽取，
+ * 再对 FFT_POINTS / ENV_DECIM 点包络做 RFFT，得到包络谱 (分辨率与原频谱相同)。
+ * 整帧只做 2 级 biquad + 一次加法抽取 + 512 点 RFFT，运算量明显小于再做一次 4096 点 RFFT。 */
+static void Biquad_Design(float32_t *c, uint8_t highpass, float32_t f0, float32_t fs)
+{
+    float32_t w0 = 2.0f * PI * f0 / fs;
+    float32_t cs = arm_cos_f32(w0);
+    float32_t alpha = arm_sin_f32(w0) * 0.70710678f;   // sin(w0) / (2Q), Q = 1/√2
+    float32_t a0 = 1.0f + alpha;
+
+    if (highpass) {
+        c[0] = 0.5f * (1.0f + cs) / a0;
+        c[1] = -(1.0f + cs) / a0;
+    } else {
+        c[0] = 0.5f * (1.0f - cs) / a0;
+        c[1] = (1.0f - cs) / a0;
+    }
+    c[2] = c[0];
+    c[3] = 2.0f * cs / a0;              // CMSIS 反馈系数取负号: y += a1*y[n-1] + a2*y[n-2]
+    c[4] = -(1.0f - alpha) / a0;
+}
+
+static void Env_Design(uint16_t fs)
+{
+    float32_t hi = ENV_BP_HI_HZ;
+    if (hi > 0.45f * (float32_t)fs) hi = 0.45f * (float32_t)fs;
+
+    s_envFs = fs;
+    s_envValid = (fs != 0 && hi > 1.5f * ENV_BP_LO_HZ);
+    if (!s_envValid) return;
+
+    Biquad_Design(&envBpCoeffs[0], 1, ENV_BP_LO_HZ, (float32_t)fs);
+    Biquad_Design(&envBpCoeffs[5], 0, hi, (float32_t)fs);
+}
+
+// 输入为原始帧 (Z 轴平面去直流后滤波)，不受 FFT 加窗影响；传感器 ADP 已做带通的帧跳过带通
+static void Calc_Envelope_Z(const int16_t *pRawData, float32_t mean, uint32_t len, AxisFeatureValue *result)
+{
+    if (s_envFs != s_CalcFs) Env_Design(s_CalcFs);
+
+    memset(result->env_peak_freq, 0, sizeof(result->env_peak_freq));
+    memset(result->env_peak_amp, 0, sizeof(result->env_peak_amp));
+    if (!s_envValid || (s_CalcFlags & ACQ_FLAG_ADP_RMS)) return;
+    uint8_t prefiltered = (s_CalcFlags & ACQ_FLAG_ADP_ENV) != 0;
+
+    // 带通 + 整流 + 抽取
+    memset(envBpState, 0, sizeof(envBpState));
+    const int16_t *pZ = RAW_AXIS(pRawData, 2);
+    uint32_t m = 0;
+    for (uint32_t off = 0; off < len; off += ENV_BLOCK) {
+        Raw_ToG(pZ + off, envBlk, ENV_BLOCK, mean);
+        if (!prefiltered) arm_biquad_cascade_df2T_f32(&S_envBp, envBlk, envBlk, ENV_BLOCK);   // df2T 可原位
+        for (uint32_t i = 0; i < ENV_BLOCK; i += ENV_DECIM) {
+            float32_t acc = 0.0f;
+            for (uint32_t j = 0; j < ENV_DECIM; j++) acc += fabsf(envBlk[i + j]);
+            envBuf[m++] = acc * (1.0f / ENV_DECIM);
+        }
+    }
+
+    // 去直流 -> 包络谱
+    float32_t envMean;
+    arm_mean_f32(envBuf, ENV_FFT_POINTS, &envMean);
+    arm_offset_f32(envBuf, -envMean, envBuf, ENV_FFT_POINTS);
+    Rfft_Forward_InPlace(&S_envRfft, envBuf);
+    envBuf[1] = 0.0f;   // Nyquist
+    arm_cmplx_mag_f32(envBuf, envBuf, ENV_FFT_POINTS / 2);
+
+    // 局部极大值中取前 ENV_PEAK_NUM 个 (插入排序)，只看 CIC 通带内 (0.4 * fs/ENV_DECIM 以下)
+    uint32_t peakIdx[ENV_PEAK_NUM] = {0};
+    float32_t peakMag[ENV_PEAK_NUM] = {0.0f};
+    uint32_t kMax = (uint32_t)(0.8f * (ENV_FFT_POINTS / 2));
+    for (uint32_t k = 2; k < kMax; k++) {
+        float32_t v = envBuf[k];
+        if (v <= envBuf[k - 1] || v < envBuf[k + 1] || v <= peakMag[ENV_PEAK_NUM - 1]) continue;
+        int32_t n = ENV_PEAK_NUM - 1;
+        while (n > 0 && peakMag[n - 1] < v) {
+            peakMag[n] = peakMag[n - 1];
+            peakIdx[n] = peakIdx[n - 1];
+            n--;
+        }
+        peakMag[n] = v;
+        peakIdx[n] = k;
+    }
+
+    float32_t freq_res = (float32_t)s_CalcFs / (float32_t)len;   // 抽取后分辨率不变
+    float32_t norm = 2.0f / (float32_t)ENV_FFT_POINTS;
+    for (uint32_t n = 0; n < ENV_PEAK_NUM; n++) {
+        if (peakIdx[n] == 0) break;
+        // 补偿 ENV_DECIM 点平均的 sinc 衰减
+        float32_t x = PI * (float32_t)peakIdx[n] / (float32_t)len;
+        float32_t droop = arm_sin_f32(x * ENV_DECIM) / (ENV_DECIM * arm_sin_f32(x));
+        result->env_peak_freq[n] = (float32_t)peakIdx[n] * freq_res;
+        result->env_peak_amp[n]  = peakMag[n] * norm / droop;
+    }
+}
+
+/* ================== 频谱峰值表 ==================
+ * 一遍扫描幅值谱，局部极大值进入容量 PEAK_TABLE_N 的小顶堆 (O(L log N))；
+ * 矩形窗用 Jacobsen 三点复数插值 δ = Re{(X[k-1] - X[k+1]) / (2X[k] - X[k-1] - X[k+1])} 得到亚 bin 频率，
+ * 幅值按 sinc 扇贝损失 πδ/sin(πδ) 修正；其他窗由较大邻 bin 与峰值之比 ρ = g(1-d)/g(d) 二分反解 d
+ * (g 为窗的归一化幅度响应，见 Win_Response)，幅值除以 g(d)。最后两两比较标注谐波 (f ≈ h·f0, h=2..10) 与
+ * 对称边带 (fa + fb ≈ 2fc)，容差半个 bin。需要复数谱，须在频域积分覆盖 data 之前调用。 */
+static void Peak_HeapPush(uint32_t *hIdx, float32_t *hVal, uint32_t *pCount, uint32_t k, float32_t v)
+{
+    uint32_t i;
+    if (*pCount < PEAK_TABLE_N) {
+        i = (*pCount)++;
+        while (i > 0 && hVal[(i - 1) / 2] > v) {   // 上浮
+            hVal[i] = hVal[(i - 1) / 2];
+            hIdx[i] = hIdx[(i - 1) / 2];
+            i = (i - 1) / 2;
+        }
+    } else {
+        if (v <= hVal[0]) return;
+        i = 0;
+        for (;;) {                                  // 替换堆顶后下沉
+            uint32_t c = 2 * i + 1;
+            if (c >= PEAK_TABLE_N) break;
+            if (c + 1 < PEAK_TABLE_N && hVal[c + 1] < hVal[c]) c++;
+            if (hVal[c] >= v) break;
+            hVal[i] = hVal[c];
+            hIdx[i] = hIdx[c];
+            i = c;
+        }
+    }
+    hVal[i] = v;
+    hIdx[i] = k;
+}
+
+/* 余弦和窗 w[n] = Σ(-1)^m a_m cos(2πmn/N) 在偏离 bin 中心 d 个 bin 处的幅度响应 (d = 0 时为 1):
+ *   g(d) = sinc(d) * |1 + Σ ratio[m] d² / (d² - m²)|，ratio[m] = (-1)^m a_m / a0
+ * d 不能取非零整数 (调用方保证 0 < d < 1)。 */
+static float32_t Win_Response(const WinInfo_t *w, float32_t d)
+{
+    float32_t d2 = d * d;
+    float32_t acc = 1.0f;
+    for (uint32_t m = 1; m <= WIN_MAX_TERMS; m++) {
+        acc += w->ratio[m - 1] * d2 / (d2 - (float32_t)(m * m));
+    }
+    float32_t x = PI * d;
+    float32_t sinc = (x > 1e-4f) ? arm_sin_f32(x) / x : 1.0f;
+    return sinc * fabsf(acc);
+}
+
+// 由 ρ = mag[k±1] / mag[k] (较大的一侧) 求偏移 d ∈ [0, 0.5]，ρ(d) 在该区间单调递增
+static float32_t Win_SolveOffset(const WinInfo_t *w, float32_t rho)
+{
+    float32_t lo = 1e-3f, hi = 0.5f;
+    if (rho <= Win_Response(w, 1.0f - lo) / Win_Response(w, lo)) return 0.0f;
+    if (rho >= 1.0f) return 0.5f;
+    for (uint32_t it = 0; it < 16; it++) {   // 0.5 / 2^16，远小于噪声引入的误差
+        float32_t mid = 0.5f * (lo + hi);
+        if (Win_Response(w, 1.0f - mid) < rho * Win_Response(w, mid)) lo = mid;
+        else hi = mid;
+    }
+    return 0.5f * (lo + hi);
+}
+
+static void Calc_PeakTable_Z(const float32_t *spec, const float32_t *mag, uint32_t len)
+{
+    uint32_t hIdx[PEAK_TABLE_N];
+    float32_t hVal[PEAK_TABLE_N];
+    uint32_t count = 0;
+    uint32_t half = len / 2;
+    SpecPeak_t tbl[PEAK_TABLE_N];
+
+    for (uint32_t k = 6; k < half - 1; k++) {   // 避开 5 个点以内的低频干扰
+        float32_t v = mag[k];
+        if (v <= mag[k - 1] || v < mag[k + 1] || v < NoiseFloor_Gate(s_NoiseFloorZ, k, 1.0f)) continue;
+        Peak_HeapPush(hIdx, hVal, &count, k, v);
+    }
+
+    // 按幅值降序 (N 很小，直接选择排序)
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t best = i;
+        for (uint32_t j = i + 1; j < count; j++) {
+            if (hVal[j] > hVal[best]) best = j;
+        }
+        float32_t tv = hVal[i]; hVal[i] = hVal[best]; hVal[best] = tv;
+        uint32_t ti = hIdx[i]; hIdx[i] = hIdx[best]; hIdx[best] = ti;
+    }
+
+    float32_t freq_res = s_CalcFs / (float32_t)len;
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t k = hIdx[i];
+        tbl[i].tag   = PEAK_TAG_NONE;
+        tbl[i].ref   = 0;
+        tbl[i].order = 0;
+
+        if (s_Win->half != NULL) {
+            int32_t side = (mag[k + 1] > mag[k - 1]) ? 1 : -1;
+            float32_t d = Win_SolveOffset(s_Win, mag[k + side] / hVal[i]);
+            tbl[i].freq = ((float32_t)k + (float32_t)side * d) * freq_res;
+            tbl[i].amp  = hVal[i] / Win_Response(s_Win, d);
+            continue;
+        }
+
+        float32_t nr = spec[2 * (k - 1)]     - spec[2 * (k + 1)];
+        float32_t ni = spec[2 * (k - 1) + 1] - spec[2 * (k + 1) + 1];
+        float32_t dr = 2.0f * spec[2 * k]     - spec[2 * (k - 1)]     - spec[2 * (k + 1)];
+        float32_t di = 2.0f * spec[2 * k + 1] - spec[2 * (k - 1) + 1] - spec[2 * (k + 1) + 1];
+        float32_t den = dr * dr + di * di;
+        float32_t delta = (den > 0.0f) ? (nr * dr + ni * di) / den : 0.0f;
+        if (delta > 0.5f) delta = 0.5f;
+        if (delta < -0.5f) delta = -0.5f;
+
+        float32_t x = PI * delta;
+        tbl[i].freq  = ((float32_t)k + delta) * freq_res;
+        tbl[i].amp   = (fabsf(x) > 1e-4f) ? hVal[i] * x / arm_sin_f32(x) : hVal[i];
+    }
+
+    // 谐波: 对每个峰找频率更低、幅值更大的基频 (表已按幅值降序，j 从 0 开始即优先强峰)
+    float32_t tol = 0.5f * freq_res;
+    for (uint32_t i = 0; i < count; i++) {
+        for (uint32_t j = 0; j < count; j++) {
+            if (j == i || tbl[j].freq >= tbl[i].freq || tbl[j].tag == PEAK_TAG_HARMONIC) continue;
+            uint32_t h = (uint32_t)(tbl[i].freq / tbl[j].freq + 0.5f);
+            if (h < 2 || h > 10) continue;
+            if (fabsf(tbl[i].freq - (float32_t)h * tbl[j].freq) < tol * (float32_t)h) {
+                tbl[i].tag = PEAK_TAG_HARMONIC;
+                tbl[i].ref = (uint8_t)j;
+                tbl[i].order = (uint8_t)h;
+                tbl[j].tag = PEAK_TAG_FUND;
+                break;
+            }
+        }
+    }
+
+    // 边带: 未归类的峰中，关于某个载波对称的一对
+    for (uint32_t c = 0; c < count; c++) {
+        for (uint32_t a = 0; a < count; a++) {
+            if (a == c || tbl[a].tag != PEAK_TAG_NONE || tbl[a].freq >= tbl[c].freq) continue;
+            for (uint32_t b = 0; b < count; b++) {
+                if (b == c || tbl[b].tag != PEAK_TAG_NONE || tbl[b].freq <= tbl[c].freq) continue;
+                if (fabsf(tbl[a].freq + tbl[b].freq - 2.0f * tbl[c].freq) < tol) {
+                    tbl[a].tag = PEAK_TAG_SIDEBAND;
+                    tbl[a].ref = (uint8_t)c;
+                    tbl[b].tag = PEAK_TAG_SIDEBAND;
+                    tbl[b].ref = (uint8_t)c;
+                    break;
+                }
+            }
+        }
+    }
+
+    taskENTER_CRITICAL();
+    memset(s_PeakTable, 0, sizeof(s_PeakTable));
+    memcpy(s_PeakTable, tbl, count * sizeof(SpecPeak_t));
+    s_PeakCount = (uint8_t)count;
+    taskEXIT_CRITICAL();
+}
+
+//频域特征计算 (Z轴: PeakFreq, PeakAmp, 2xAmp, 频域积分速度/位移)
 static void Calc_FreqDomain_Z(float32_t *data, uint32_t len , AxisFeatureValue *result)
 {   
     // 执行 RFFT
     // data 是输入 (时域)，也是输出 (频域 packed)
-    arm_rfft_fast_f32(&S_rfft, data, data, 0);
+    Rfft_Forward_InPlace(&S_rfft, data);
 
     // 计算幅值 (Modulus)
-    // 输入 len 个 float (复数 packed)，计算出 len/2 个幅值
-    arm_cmplx_mag_f32(data, data, len / 2);
+    // 输入 len 个 float (复数 packed)，计算出 len/2 个幅值，复数谱保留给频域积分
+    arm_cmplx_mag_f32(data, magBuf, len / 2);
 
-    // 归一化 & 找峰值
-    float32_t norm = 2.0f / (float32_t)len;
-    data[0] /= (float32_t)len; // DC
+    // 归一化 & 找峰值 (除以窗的相干增益，还原正弦幅值)
+    float32_t norm = 2.0f / ((float32_t)len * s_Win->cg);
+    magBuf[0] /= (float32_t)len * s_Win->cg; // DC
     
     float32_t maxAmp = 0.0f;
     uint32_t maxIndex = 0;
 
     for (uint32_t i = 1; i < len / 2; i++) {
-        data[i] *= norm;
-        
-        // 避开 5 个点以内的低频干扰
-        if (i > 5 && data[i] > maxAmp) {
-            maxAmp = data[i];
+        magBuf[i] *= norm;
+    }
+    NoiseFloor_Estimate(magBuf, 1, len / 2, s_NoiseFloorZ);
+
+    // 避开 5 个点以内的低频干扰，只在超过所在频带 SNR 门限的 bin 中找最大值
+    for (uint32_t i = 6; i < len / 2; i++) {
+        if (magBuf[i] > maxAmp && magBuf[i] >= NoiseFloor_Gate(s_NoiseFloorZ, i, 1.0f)) {
+            maxAmp = magBuf[i];
             maxIndex = i;
         }
     }
-		if (maxAmp < MIN_VALID_PEAK_AMP) {
+		if (maxIndex == 0) {
 		// 如果最大值都没超过门限，说明是静置噪音
 		result->peakFreq = 0.0f; // 强制置零
 		result->peakAmp  = 0.0f; // 或者保留 maxAmp 作为底噪参考，看你需求
 		result->amp2x    = 0.0f;
 		} else {
-    float32_t freq_res = g_cfg_freq_hz / (float32_t)len;
+    float32_t freq_res = s_CalcFs / (float32_t)len;
     result->peakFreq = (float32_t)maxIndex * freq_res;
     result->peakAmp  = maxAmp;
 
     // 2x 频
     uint32_t idx_2x = maxIndex * 2;
-    if (idx_2x < len / 2) result->amp2x = data[idx_2x];
+    if (idx_2x < len / 2) result->amp2x = magBuf[idx_2x];
     else result->amp2x = 0.0f;
 		}
+
+    Calc_PeakTable_Z(data, magBuf, len);
+    Calc_FreqIntegrate_Z(data, len, result);
 }
-//去直流取绝对值
-static void Remove_DC_And_Rectify(float *data, uint32_t len)
+
+/* ================== X/Y 频谱 (二合一复数 FFT) ==================
+ * X/Y 先用 7 抽头半带 FIR [-1 0 9 16 9 0 -1]/32 2 倍抽取 (频率分辨率不变，带宽降为 ODR/4)，
+ * 再把 X+jY 装进一个 2048 点 CFFT，按
+ *   X[k] = (Z[k] + conj(Z[M-k])) / 2,  Y[k] = (Z[k] - conj(Z[M-k])) / 2j
+ * 分离。数据放在 fftBuf 中 (Z 轴已处理完)，不增加 RAM。与三轴独立 RFFT 的耗时对比用 ALGO_FFT_BENCH 实测。
+ * 半带滤波器在 0.1*ODR 处衰减 < 0.3dB、镜像抑制 > 30dB，越接近 ODR/4 越差，所以 X/Y 峰值
+ * 只在 0.1875*ODR (25.6kHz 时 4.8kHz) 以下搜索并补偿通带跌落，更高频的 X/Y 分量不报。 */
+#define XY_DECIM_POINTS   (FFT_POINTS / 2)
+#define XY_SEARCH_BINS    (XY_DECIM_POINTS * 3 / 8)
+
+// 半带 FIR 的幅频响应, x = f / fs
+static float32_t XY_HalfbandGain(float32_t x)
 {
-    Remove_DC(data, len);
+    float32_t w = 2.0f * PI * x;
+    return (16.0f + 18.0f * arm_cos_f32(w) - 2.0f * arm_cos_f32(3.0f * w)) / 32.0f;
+}
 
-    for (uint32_t i = 0; i < len; i++) {
-        if (data[i] < 0.0f) {
-            data[i] = -data[i];
+static void XY_PickPeak(const float32_t *mag, uint32_t len, AxisFeatureValue *result)
+{
+    float32_t norm = 2.0f / ((float32_t)XY_DECIM_POINTS * s_Win->cg);
+    float32_t maxAmp = 0.0f;
+    uint32_t maxIndex = 0;
+    float32_t floor[XY_DECIM_POINTS / 2 / NF_BAND_BINS];
+
+    NoiseFloor_Estimate(mag, 2, XY_DECIM_POINTS / 2, floor);
+    for (uint32_t i = 6; i < XY_SEARCH_BINS; i++) {   // 避开 5 个点以内的低频干扰
+        if (mag[2 * i] > maxAmp && mag[2 * i] * norm >= NoiseFloor_Gate(floor, i, norm)) {
+            maxAmp = mag[2 * i];
+            maxIndex = i;
         }
     }
+    maxAmp = maxAmp * norm / XY_HalfbandGain((float32_t)maxIndex / (float32_t)len);
+
+    if (maxIndex == 0) {
+        result->peakFreq = 0.0f;
+        result->peakAmp  = 0.0f;
+        result->amp2x    = 0.0f;
+    } else {
+        float32_t freq_res = s_CalcFs / (float32_t)len;
+        uint32_t idx_2x = maxIndex * 2;
+        result->peakFreq = (float32_t)maxIndex * freq_res;
+        result->peakAmp  = maxAmp;
+        result->amp2x    = (idx_2x < XY_DECIM_POINTS / 2)
+                         ? mag[2 * idx_2x] * norm / XY_HalfbandGain((float32_t)idx_2x / (float32_t)len)
+                         : 0.0f;
+    }
 }
-//包络
-static void Calc_Envelope_Stats(float32_t *env_data, uint32_t len, AxisFeatureValue *result)
+
+static void Calc_FreqDomain_XY(const int16_t *pRawData, float32_t *work, uint32_t len)
 {
-    float32_t sum = 0.0f;
-    float32_t sumSq = 0.0f;
-    float32_t maxVal = 0.0f;
-    
+    const float32_t meanX = s_Stage[0].mean, meanY = s_Stage[1].mean;
+    const float32_t S = KX134_SENSITIVITY / 32.0f;
+    const uint32_t winStride = WIN_TABLE_LEN / XY_DECIM_POINTS;
+    const int16_t *pAxis[2] = { RAW_AXIS(pRawData, 0), RAW_AXIS(pRawData, 1) };
+    int32_t last = (int32_t)len - 1;
+
+    // 半带抽取 + 去直流 + 加窗，X 放实部，Y 放虚部
+    for (int32_t n = 0; n < (int32_t)(len / 2); n++) {
+        float32_t w = Win_Value(s_Win, (uint32_t)n, winStride);
+        int32_t c = 2 * n;
+        int32_t i1 = (c - 1 < 0) ? 0 : c - 1;
+        int32_t i3 = (c - 3 < 0) ? 0 : c - 3;
+        int32_t j1 = (c + 1 > last) ? last : c + 1;
+        int32_t j3 = (c + 3 > last) ? last : c + 3;
+        for (uint32_t k = 0; k < 2; k++) {
+            const int16_t *p = pAxis[k];
+            int32_t acc = 16 * p[c] + 9 * (p[i1] + p[j1]) - (p[i3] + p[j3]);
+            work[2 * n + k] = ((float32_t)acc * S - (k == 0 ? meanX : meanY)) * w;
+        }
+    }
+
+    arm_cfft_f32(&arm_cfft_sR_f32_len2048, work, 0, 1);
+
+    // 成对分离 (k, M-k)，|X[k]| 写回 work[2k]，|Y[k]| 写回 work[2k+1]
+    uint32_t M = XY_DECIM_POINTS;
+    float32_t a0 = work[0], b0 = work[1];
+    work[0] = fabsf(a0);
+    work[1] = fabsf(b0);
+    for (uint32_t k = 1; k < M / 2; k++) {
+        float32_t a = work[2 * k], b = work[2 * k + 1];
+        float32_t c = work[2 * (M - k)], d = work[2 * (M - k) + 1];
+        float32_t xr = a + c, xi = b - d;
+        float32_t yr = b + d, yi = c - a;
+        float32_t mx, my;
+        arm_sqrt_f32(xr * xr + xi * xi, &mx);
+        arm_sqrt_f32(yr * yr + yi * yi, &my);
+        work[2 * k]     = 0.5f * mx;
+        work[2 * k + 1] = 0.5f * my;
+    }
+
+    XY_PickPeak(&work[0], len, &X_data);
+    XY_PickPeak(&work[1], len, &Y_data);
+}
+
+#if ALGO_FFT_BENCH
+volatile uint32_t g_FftBenchCycles[2];   // [0] 三轴独立 4096 点 RFFT，[1] Z RFFT + X/Y 二合一
+
+// 上电跑一次，用 g_SensorRawBuffer[0] 当输入，结果在调试器里看 g_FftBenchCycles
+static void Calc_BenchFFT(void)
+{
+    const int16_t *pRaw = &g_SensorRawBuffer[0][0];
+    uint32_t t0;
+
+    t0 = DWT->CYCCNT;
+    for (uint32_t k = 0; k < AXIS_COUNT; k++) {
+        Raw_ToG(RAW_AXIS(pRaw, k), fftBuf, FFT_POINTS, 0.0f);
+        Rfft_Forward_InPlace(&S_rfft, fftBuf);
+        arm_cmplx_mag_f32(fftBuf, magBuf, FFT_POINTS / 2);
+    }
+    g_FftBenchCycles[0] = DWT->CYCCNT - t0;
+
+    t0 = DWT->CYCCNT;
+    Raw_ToG(RAW_AXIS(pRaw, 2), fftBuf, FFT_POINTS, 0.0f);
+    Rfft_Forward_InPlace(&S_rfft, fftBuf);
+    arm_cmplx_mag_f32(fftBuf, magBuf, FFT_POINTS / 2);
+    Calc_FreqDomain_XY(pRaw, fftBuf, FFT_POINTS);
+    g_FftBenchCycles[1] = DWT->CYCCNT - t0;
+}
+#endif
+
+#endif /* !ALGO_FIXED_POINT */
+
+#if ALGO_FIXED_POINT
+/* ================== Q15 定点流水线 ==================
+ * 时域统计整数累加，频谱用 arm_cfft_q15 (N/2 点复数) + 原位 split，缓冲 N 个 q15 (8KB)。
+ * FFT 输入按块浮点放大 (headroom) 后加窗。与浮点路径相比 rms/peakAmp 相差 < 0.2%，disp_pp < 7%。 */
+#if   FFT_POINTS == 1024
+#define CFFT_Q15_HALF   (&arm_cfft_sR_q15_len512)
+#elif FFT_POINTS == 2048
+#define CFFT_Q15_HALF   (&arm_cfft_sR_q15_len1024)
+#elif FFT_POINTS == 4096
+#define CFFT_Q15_HALF   (&arm_cfft_sR_q15_len2048)
+#elif FFT_POINTS == 8192
+#define CFFT_Q15_HALF   (&arm_cfft_sR_q15_len4096)
+#else
+#error "ALGO_FIXED_POINT: FFT_POINTS must be 1024/2048/4096/8192"
+#endif
+
+typedef struct
+{
+    int32_t  sum;       // Σr
+    int16_t  minVal;
+    int16_t  maxVal;
+    int32_t  m0;        // 取整均值 (去直流基准)
+    int32_t  sumD;      // Σd, d = r - m0
+    uint64_t sumD2;     // Σd^2
+    int64_t  sumD3;     // Σd^3
+    uint64_t sumD4;     // Σ(d^2 >> h)^2, s4 = 2h
+    uint8_t  s4;
+    int64_t  sumV;      // 积分累加 acc (单位 LSB*2 个采样间隔)
+    uint64_t sumV2;     // Σ(acc >> vs)^2
+    int64_t  sumIV;     // Σ(i+1)*acc (补偿取整均值带来的斜坡)
+    uint8_t  vs;
+} AxisStageQ_t;
+
+static AxisStageQ_t s_StageQ[AXIS_COUNT];
+
+static uint32_t BitLen_U32(uint32_t v)
+{
+    uint32_t n = 0;
+    while (v) { n++; v >>= 1; }
+    return n;
+}
+
+// Stage 1 (Q15): 整数和/最值 (各轴平面连续)
+static void StageQ_Convert(const int16_t *pRawData, uint32_t len)
+{
+    for (uint32_t k = 0; k < AXIS_COUNT; k++) {
+        const int16_t *pAxis = RAW_AXIS(pRawData, k);
+        AxisStageQ_t *st = &s_StageQ[k];
+        int32_t half = (int32_t)len / 2;
+        int32_t sum = Raw_Sum(pAxis, len);
+        uint32_t idx;
+
+        arm_min_q15(pAxis, len, &st->minVal, &idx);
+        arm_max_q15(pAxis, len, &st->maxVal, &idx);
+        st->sum = sum;
+        st->m0 = (sum >= 0) ? (sum + half) / (int32_t)len : -((-sum + half) / (int32_t)len);
+    }
+}
+
+// Stage 2 (Q15): 围绕取整均值的整数矩 + 整数梯形积分 (逐轴)，Z 轴放大后写入 fftBufQ
+static uint32_t StageQ_Centered(const int16_t *pRawData, uint32_t len, q15_t *zOut)
+{
+    for (uint32_t k = 0; k < AXIS_COUNT; k++) {
+        const int16_t *pAxis = RAW_AXIS(pRawData, k);
+        AxisStageQ_t *st = &s_StageQ[k];
+        int32_t dMax = st->maxVal - st->m0;
+        int32_t dMin = st->m0 - st->minVal;
+        uint32_t b = BitLen_U32((uint32_t)((dMax > dMin) ? dMax : dMin));
+
+        // 保证 len * d^4 与 len * acc^2 不溢出 64 位 (len <= 2^12, |acc| <= 2^(b+13))
+        st->s4 = (4 * b > 51) ? (uint8_t)(((4 * b - 51) + 1) & ~1u) : 0;
+        st->vs = (b > 12) ? (uint8_t)(b - 12) : 0;
+        st->sumD = 0;
+        st->sumD2 = 0;
+        st->sumD3 = 0;
+        st->sumD4 = 0;
+        st->sumV = 0;
+        st->sumV2 = 0;
+        st->sumIV = 0;
+        int32_t accPrev = pAxis[0] - st->m0;
+        int32_t acc = 0;
+
+        for (uint32_t i = 0; i < len; i++) {
+            int32_t d = pAxis[i] - st->m0;
+            int64_t d2 = (int64_t)d * d;
+
+            st->sumD  += d;
+            st->sumD2 += (uint64_t)d2;
+            st->sumD3 += d2 * d;
+            uint64_t d2s = (uint64_t)d2 >> (st->s4 / 2);
+            st->sumD4 += d2s * d2s;
+
+            // 梯形积分 (整数): acc += d_prev + d
+            acc += accPrev + d;
+            accPrev = d;
+            int32_t v = acc >> st->vs;
+            st->sumV  += acc;
+            st->sumV2 += (uint64_t)((int64_t)v * v);
+            st->sumIV += (int64_t)(i + 1) * acc;
+        }
+    }
+
+    // Z 轴块浮点: 左移到 q15 满量程，再乘 q15 窗
+    const int16_t *pZ = RAW_AXIS(pRawData, 2);
+    const q15_t *win = s_Win->half;
+    uint32_t winStride = WIN_TABLE_LEN / len;
+    int32_t zM0 = s_StageQ[2].m0;
+    int32_t zMax = s_StageQ[2].maxVal - zM0;
+    int32_t zMin = zM0 - s_StageQ[2].minVal;
+    uint32_t zPeak = (uint32_t)((zMax > zMin) ? zMax : zMin);
+    uint32_t headroom = 0;
+    while (zPeak != 0 && (zPeak << (headroom + 1)) <= 32767u) headroom++;
+
     for (uint32_t i = 0; i < len; i++) {
-        float32_t val = env_data[i];
-        
-        // 累加计算均值 (对于包络信号，均值反映了整体噪声水平)
-        sum += val;
-        
-        // 累加计算 RMS (能量)
-        sumSq += val * val;
-        
-        // 寻找峰值 (冲击最大值)
-        if (val > maxVal) maxVal = val;
-    }
-    // 包络 RMS
-    result->envelope_vrms = sqrtf(sumSq / (float32_t)len);
-    
-    // 包络峰值 (反映轴承缺陷的冲击强度)
-    result->envelope_peak = maxVal;
+        int32_t z = (pZ[i] - zM0) << headroom;
+        if (z > 32767) z = 32767;
+        if (z < -32768) z = -32768;
+        if (win != NULL) {
+            uint32_t j = i * winStride;
+            if (j > WIN_TABLE_LEN / 2) j = WIN_TABLE_LEN - j;
+            z = (z * win[j]) >> 15;
+        }
+        zOut[i] = (q15_t)z;
+    }
+    return headroom;
+}
+
+// 时域特征输出 (Q15): 整数矩 -> 物理量
+static void StageQ_Finalize(const AxisStageQ_t *st, uint32_t len, AxisFeatureValue *result)
+{
+    float32_t n  = (float32_t)len;
+    float32_t f  = (float32_t)st->sumD / n;                // 真均值与取整均值之差 (|f| <= 0.5 LSB)
+    float32_t S  = KX134_SENSITIVITY;
+    float32_t m2 = (float32_t)st->sumD2 - n * f * f;
+    float32_t m4 = (float32_t)st->sumD4 * (float32_t)(1ULL << st->s4)
+                 - 4.0f * f * (float32_t)st->sumD3
+                 + 6.0f * f * f * (float32_t)st->sumD2
+                 - 3.0f * n * f * f * f * f;
+
+    result->mean = ((float32_t)st->m0 + f) * S;
+    result->pp   = (float32_t)(st->maxVal - st->minVal) * S;
+    result->kurt = (m2 * S * S < 1e-9f) ? 0.0f : n * m4 / (m2 * m2);
+
+    if (s_CalcFs != 0) {
+        // acc_i 以取整均值积分，真实积分还需减去斜坡 2f(i+1)
+        float32_t vsc = (float32_t)(1UL << st->vs);
+        float32_t si  = n * (n + 1.0f) / 2.0f;                    // Σ(i+1)
+        float32_t si2 = n * (n + 1.0f) * (2.0f * n + 1.0f) / 6.0f; // Σ(i+1)^2
+        float32_t v1  = (float32_t)st->sumV - 2.0f * f * si;
+        float32_t v2  = (float32_t)st->sumV2 * vsc * vsc - 4.0f * f * (float32_t)st->sumIV + 4.0f * f * f * si2;
+        float32_t var = (v2 - v1 * (v1 / n)) / n;
+        float32_t k   = 0.5f / (float32_t)s_CalcFs * G_TO_MM_S2 * S;   // acc -> mm/s
+        result->rms = sqrtf(var > 0.0f ? var : 0.0f) * k;
+    } else {
+        result->rms = sqrtf(m2 / n) * S;
+    }
+}
+
+// q15 实 FFT (原位): cfft_q15(N/2) + split，输出 X/N，格式同 arm_rfft_q15 (data[1] 置 0，不保留 Nyquist)
+static void Rfft_Q15_InPlace(q15_t *data, uint32_t len)
+{
+    uint32_t half = len / 2;                 // 复数点数 M
+    uint32_t modifier = 8192u / len;         // realCoefA/BQ15 按 8192 点实 FFT 生成
+
+    arm_cfft_q15(CFFT_Q15_HALF, data, 0, 1);
+
+    // split: X[k] = Z[k]*A[k] + conj(Z[M-k])*B[k]，成对处理 (k, M-k) 使得可以原位写回
+    for (uint32_t k = 1; k <= half / 2; k++) {
+        uint32_t m = half - k;
+        q63_t zr = data[2 * k], zi = data[2 * k + 1];
+        q63_t wr = data[2 * m], wi = data[2 * m + 1];
+        const q15_t *pA = &realCoefAQ15[2 * modifier * k];
+        const q15_t *pB = &realCoefBQ15[2 * modifier * k];
+        const q15_t *pAm = &realCoefAQ15[2 * modifier * m];
+        const q15_t *pBm = &realCoefBQ15[2 * modifier * m];
+
+        data[2 * k]     = (q15_t)((zr * pA[0] - zi * pA[1] + wr * pB[0] + wi * pB[1]) >> 16);
+        data[2 * k + 1] = (q15_t)((zi * pA[0] + zr * pA[1] + wr * pB[1] - wi * pB[0]) >> 16);
+        if (m != k) {
+            data[2 * m]     = (q15_t)((wr * pAm[0] - wi * pAm[1] + zr * pBm[0] + zi * pBm[1]) >> 16);
+            data[2 * m + 1] = (q15_t)((wi * pAm[0] + wr * pAm[1] + zr * pBm[1] - zi * pBm[0]) >> 16);
+        }
+    }
+    data[0] = (q15_t)(((q31_t)data[0] + data[1]) >> 1);   // DC
+    data[1] = 0;
+}
+
+// q15 复数谱 bin k 的幅值 (q15 单位)
+static inline float32_t MagQ15(const q15_t *data, uint32_t k)
+{
+    float32_t re = (float32_t)data[2 * k], im = (float32_t)data[2 * k + 1];
+    return sqrtf(re * re + im * im);
+}
+
+// 频域特征 (Q15): 主峰/2x，幅值按需由复数谱计算
+static void Calc_FreqDomain_Z_Q15(q15_t *data, uint32_t len, uint32_t headroom, AxisFeatureValue *result)
+{
+    uint32_t half = len / 2;
+
+    Rfft_Q15_InPlace(data, len);
+
+    // 复数谱为 X/N (q15)，单边幅值 2|X|/N，再做窗的相干增益修正
+    float32_t toG = 2.0f * KX134_SENSITIVITY / ((float32_t)(1UL << headroom) * s_Win->cg);
+
+    // 噪声底 (q15 幅值单位)
+    float32_t floor[FFT_POINTS / 2 / NF_BAND_BINS];
+    for (uint32_t b = 0; b < half / NF_BAND_BINS; b++) {
+        for (uint32_t i = 0; i < NF_BAND_BINS; i++) nfScratch[i] = MagQ15(data, b * NF_BAND_BINS + i);
+        floor[b] = Select_Kth(nfScratch, NF_BAND_BINS, NF_BAND_BINS * NF_PERCENTILE / 100);
+    }
+
+    float32_t maxAmp = 0.0f;
+    uint32_t maxIndex = 0;
+    for (uint32_t i = 6; i < half; i++) {   // 避开 5 个点以内的低频干扰
+        float32_t m = MagQ15(data, i);
+        if (m > maxAmp && m * toG >= NoiseFloor_Gate(floor, i, toG)) {
+            maxAmp = m;
+            maxIndex = i;
+        }
+    }
+
+    if (maxIndex == 0) {
+        result->peakFreq = 0.0f;
+        result->peakAmp  = 0.0f;
+        result->amp2x    = 0.0f;
+    } else {
+        float32_t freq_res = s_CalcFs / (float32_t)len;
+        uint32_t idx_2x = maxIndex * 2;
+        result->peakFreq = (float32_t)maxIndex * freq_res;
+        result->peakAmp  = maxAmp * toG;
+        result->amp2x    = (idx_2x < half) ? MagQ15(data, idx_2x) * toG : 0.0f;
+    }
+}
+
+/* 频域积分 (Q15): 加速度 q15 谱的截断噪声经 1/ω² 放大太多，改对整数梯形积分的速度波形加 Hann 窗重做 q15 FFT。
+ * 速度按梯形积分频响 tan(θ)/θ 修正；位移 = V/(jω)·H_hp，fs/4 以下的 bin 换成 float 做 N/2 点实逆 FFT */
+static void Calc_FreqIntegrate_Z_Q15(q15_t *data, const int16_t *pZ, const AxisStageQ_t *st,
+                                     uint32_t len, AxisFeatureValue *result)
+{
+    result->vel_rms_iso = 0.0f;
+    result->disp_pp = 0.0f;
+    if (s_CalcFs == 0) return;
+
+    uint32_t half = len / 2;
+    float32_t n = (float32_t)len;
+    const WinInfo_t *win = &g_WinInfo[WIN_HANN];
+    uint32_t winStride = WIN_TABLE_LEN / len;
+
+    // 速度波形去线性趋势 (最小二乘，用 Stage 2 的整数累加量): 非整周期信号去均值后积分会留下斜坡，
+    // 加窗后经 1/ω 落在最低几个 bin。取整均值带来的斜坡 2f(i+1) 也一并去掉
+    float32_t sjj   = n * (n * n - 1.0f) / 12.0f;                                    // Σ(j - j̄)², j = i+1
+    float32_t slope = (float32_t)(2 * st->sumIV - (int64_t)(len + 1) * st->sumV) * 0.5f / sjj;
+    float32_t vMean = (float32_t)st->sumV / n;
+    float32_t jMean = 0.5f * (n + 1.0f);
+
+    // 两遍: 先求峰值定块浮点比例，再加窗写入 q15
+    float32_t vPeak = 0.0f, toQ = 0.0f;
+    for (uint32_t pass = 0; pass < 2; pass++) {
+        int32_t accPrev = pZ[0] - st->m0;
+        int32_t acc = 0;
+        for (uint32_t i = 0; i < len; i++) {
+            int32_t d = pZ[i] - st->m0;
+            acc += accPrev + d;
+            accPrev = d;
+            float32_t v = (float32_t)acc - vMean - slope * ((float32_t)(i + 1) - jMean);
+            if (pass == 0) {
+                if (fabsf(v) > vPeak) vPeak = fabsf(v);
+            } else {
+                data[i] = (q15_t)lrintf(v * toQ * Win_Value(win, i, winStride));
+            }
+        }
+        if (vPeak == 0.0f) return;
+        toQ = 32000.0f / vPeak;
+    }
+
+    Rfft_Q15_InPlace(data, len);
+
+    float32_t toV = 1.0f / toQ / (float32_t)s_CalcFs * G_TO_MM_S2 * KX134_SENSITIVITY;   // q15 -> 单边速度幅值 mm/s
+    float32_t freq_res = s_CalcFs / n;
+    float32_t w_res = 2.0f * PI * freq_res;
+    float32_t velSumSq = 0.0f;
+
+    for (uint32_t k = 1; k < half; k++) {
+        float32_t fk = (float32_t)k * freq_res;
+        if (fk < INTEG_BAND_LO_HZ) continue;
+        if (fk > INTEG_BAND_HI_HZ) break;
+        float32_t th = PI * (float32_t)k / n;
+        float32_t a = MagQ15(data, k) * toV * tanf(th) / th;
+        velSumSq += a * a;
+    }
+    result->vel_rms_iso = sqrtf(0.5f * velSumSq / win->pg);
+
+    // 位移: float bin k 覆盖 q15 bin 2k/2k+1，从高到低处理时均已读过。
+    // 逆变换含 1/L，谱乘 L/N 得 x[2n]；toV 为单边幅值，复数谱还需除 2
+    float32_t *dBuf = (float32_t *)(void *)data;
+    float32_t toD = toV * 0.5f * (float32_t)half * 1000.0f;        // q15 -> um * ω
+    for (uint32_t k = half / 2 - 1; k >= 1; k--) {
+        float32_t re = data[2 * k], im = data[2 * k + 1];
+        float32_t fk = (float32_t)k * freq_res;
+        if (fk > INTEG_BAND_HI_HZ) {
+            dBuf[2 * k] = 0.0f;
+            dBuf[2 * k + 1] = 0.0f;
+            continue;
+        }
+        float32_t th = PI * (float32_t)k / n;
+        float32_t r  = fk / INTEG_HP_CORNER_HZ;
+        float32_t r2 = r * r;
+        float32_t hp = r2 / sqrtf(1.0f + r2 * r2);
+        float32_t gd = hp * toD * tanf(th) / th / ((float32_t)k * w_res);
+        dBuf[2 * k]     = im * gd;      // V / (jω)
+        dBuf[2 * k + 1] = -re * gd;
+    }
+    dBuf[0] = 0.0f;   // DC
+    dBuf[1] = 0.0f;   // Nyquist (fs/4)
+
+    Rfft_Inverse_InPlace(&S_dispRfft, dBuf);
+
+    float32_t dMin, dMax;
+    uint32_t idx;
+    arm_min_f32(dBuf, half, &dMin, &idx);
+    arm_max_f32(dBuf, half, &dMax, &idx);
+    result->disp_pp = dMax - dMin;
+}
+
+static void Process_Data_Q15(const int16_t *pRawData)
+{
+    StageQ_Convert(pRawData, FFT_POINTS);
+    uint32_t headroom = StageQ_Centered(pRawData, FFT_POINTS, fftBufQ);
+
+    StageQ_Finalize(&s_StageQ[0], FFT_POINTS, &X_data);
+    StageQ_Finalize(&s_StageQ[1], FFT_POINTS, &Y_data);
+    StageQ_Finalize(&s_StageQ[2], FFT_POINTS, &Z_data);
+    Z_data.mean =  Z_data.mean - 1;
+
+    // 包络 (去直流后整流): |d| 的 RMS 即标准差，峰值由最值直接得到
+    {
+        const AxisStageQ_t *st = &s_StageQ[2];
+        float32_t n = (float32_t)FFT_POINTS;
+        float32_t f = (float32_t)st->sumD / n;
+        float32_t m2 = (float32_t)st->sumD2 - n * f * f;
+        float32_t up = (float32_t)(st->maxVal - st->m0) - f;
+        float32_t dn = (float32_t)(st->m0 - st->minVal) + f;
+        Z_data.envelope_vrms = sqrtf(m2 / n) * KX134_SENSITIVITY;
+        Z_data.envelope_peak = ((up > dn) ? up : dn) * KX134_SENSITIVITY;
+    }
+
+    //快照 (原始采样 + 直流分量，去直流在发送时完成)
+    if (g_SnapshotReq == 1) {
+        float32_t mean = (float32_t)s_StageQ[2].m0 + (float32_t)s_StageQ[2].sumD / (float32_t)FFT_POINTS;
+        taskENTER_CRITICAL();
+        memcpy(g_WaveZ_Tx, RAW_AXIS(pRawData, 2), sizeof(g_WaveZ_Tx));
+        g_WaveZ_Mean = mean;
+        taskEXIT_CRITICAL();
+        g_SnapshotReq = 0;
+    }
+    Calc_FreqDomain_Z_Q15(fftBufQ, FFT_POINTS, headroom, &Z_data);
+    Calc_FreqIntegrate_Z_Q15(fftBufQ, RAW_AXIS(pRawData, 2), &s_StageQ[2], FFT_POINTS, &Z_data);
+
+    // 定点模式不做 X/Y 频谱与包络谱，按不可用上报
+    AxisFeatureValue *xy[2] = { &X_data, &Y_data };
+    for (uint32_t k = 0; k < 2; k++) {
+        xy[k]->peakFreq = ALGO_NA_VALUE;
+        xy[k]->peakAmp  = ALGO_NA_VALUE;
+        xy[k]->amp2x    = ALGO_NA_VALUE;
+    }
+    for (uint32_t n = 0; n < ENV_PEAK_NUM; n++) {
+        Z_data.env_peak_freq[n] = ALGO_NA_VALUE;
+        Z_data.env_peak_amp[n]  = ALGO_NA_VALUE;
+    }
+}
+#endif /* ALGO_FIXED_POINT */
+
+/* ================== 逐水位流式累加 ==================
+ * 每个 FIFO 水位块 DMA 完成后由 DataTask 调用，先求块内均值与中心矩，
+ * 再用 Pébay 公式合并到整帧累加量，帧结束时只剩合并结果的拷贝。
+ * 与整帧两遍算法相比，mean/pp 误差在 float 舍入量级，kurt 相对误差 < 1e-4。
+ */
+static StreamAxisAcc_t s_StreamAcc[AXIS_COUNT];          // 正在采集的帧
+static StreamAxisAcc_t s_StreamFrame[FRAME_POOL_SLOTS][AXIS_COUNT];  // 已完成帧 (按帧槽位)
+
+void Stream_Reset(void)
+{
+    memset(s_StreamAcc, 0, sizeof(s_StreamAcc));
+}
+
+// 合并一个子集 (nb, meanB, M2b..M4b) 到累加量 acc
+static void Stream_Merge(StreamAxisAcc_t *acc, uint32_t nb, float32_t meanB,
+                         float32_t M2b, float32_t M3b, float32_t M4b)
+{
+    if (acc->n == 0) {
+        acc->n = nb;
+        acc->mean = meanB;
+        acc->M2 = M2b;
+        acc->M3 = M3b;
+        acc->M4 = M4b;
+        return;
+    }
+
+    float32_t na = (float32_t)acc->n;
+    float32_t fb = (float32_t)nb;
+    float32_t n  = na + fb;
+    float32_t delta  = meanB - acc->mean;
+    float32_t delta2 = delta * delta;
+    float32_t dn  = delta / n;
+    float32_t dn2 = dn * dn;
+    float32_t M2a = acc->M2;
+    float32_t M3a = acc->M3;
+
+    acc->M4 = acc->M4 + M4b
+            + delta2 * dn2 * na * fb * (na * na - na * fb + fb * fb) / n
+            + 6.0f * dn2 * (na * na * M2b + fb * fb * M2a)
+            + 4.0f * dn * (na * M3b - fb * M3a);
+    acc->M3 = M3a + M3b
+            + delta * dn2 * na * fb * (na - fb)
+            + 3.0f * dn * (na * M2b - fb * M2a);
+    acc->M2 = M2a + M2b + delta * dn * na * fb;
+    acc->mean += dn * fb;
+    acc->n += nb;
 }
 
+// 累加帧内刚写入的一块 [offset, offset + count)，各轴平面连续
+void Stream_AccumulateBlock(const int16_t *pFrame, uint32_t offset, uint32_t count)
+{
+    if (count == 0) return;
+
+    for (uint32_t k = 0; k < AXIS_COUNT; k++) {
+        StreamAxisAcc_t *acc = &s_StreamAcc[k];
+        const int16_t *pBlock = RAW_AXIS(pFrame, k) + offset;
+        q15_t minRaw, maxRaw;
+        q63_t sumSqRaw;
+        uint32_t idx;
+
+        // 和 / 平方和 / 最值在原始整数上求 (精确)，再换算为 g
+        arm_min_q15(pBlock, count, &minRaw, &idx);
+        arm_max_q15(pBlock, count, &maxRaw, &idx);
+        arm_power_q15(pBlock, count, &sumSqRaw);
+        float32_t sum = (float32_t)Raw_Sum(pBlock, count) * KX134_SENSITIVITY;
+        float32_t sumSq = (float32_t)sumSqRaw * (KX134_SENSITIVITY * KX134_SENSITIVITY);
+        float32_t minVal = (float32_t)minRaw * KX134_SENSITIVITY;
+        float32_t maxVal = (float32_t)maxRaw * KX134_SENSITIVITY;
+        float32_t meanB = sum / (float32_t)count;
+
+        // 块内中心矩 (块很小，第二遍数据仍在刚写完的平面里)
+        float32_t M2b = 0.0f, M3b = 0.0f, M4b = 0.0f;
+        for (uint32_t i = 0; i < count; i++) {
+            float32_t diff = (float)pBlock[i] * KX134_SENSITIVITY - meanB;
+            float32_t diff2 = diff * diff;
+            M2b += diff2;
+            M3b += diff2 * diff;
+            M4b += diff2 * diff2;
+        }
+
+        if (acc->n == 0) {
+            acc->minVal = minVal;
+            acc->maxVal = maxVal;
+        } else {
+            if (minVal < acc->minVal) acc->minVal = minVal;
+            if (maxVal > acc->maxVal) acc->maxVal = maxVal;
+        }
+        acc->sum += sum;
+        acc->sumSq += sumSq;
+        Stream_Merge(acc, count, meanB, M2b, M3b, M4b);
+    }
+}
+
+// 一帧采集完成: 把累加结果转存到该帧的槽位，并为下一帧清零
+void Stream_FinishFrame(uint8_t slot)
+{
+    memcpy(s_StreamFrame[slot], s_StreamAcc, sizeof(s_StreamAcc));
+    Stream_Reset();
+}
+
+const StreamAxisAcc_t* Stream_GetFrame(uint8_t slot)
+{
+    return s_StreamFrame[slot];
+}
+
+/* ================== Welch 平均功率谱 (Z 轴) ==================
+ * 段长 WELCH_SEG_POINTS、50% 重叠、Hann 窗。DataTask 每凑满 WELCH_HOP 点，
+ * 用上一个半段和刚到的半段 (都还在原始帧缓冲里) 拼成一段，去均值加窗后做 RFFT，
+ * 单边功率谱按 1/(fs*Σw²) 归一化为 g²/Hz 累加到平均谱。常驻内存只有一段工作区 + 平均谱。
+ * 线性平均: 帧内各段等权，帧结束后重新开始；指数平均: 跨帧连续，前 N 段退化为线性平均。
+ */
+#if ALGO_WELCH_PSD
+
+#if (FFT_POINTS % WELCH_HOP) != 0
+#error "WELCH_HOP must divide FFT_POINTS"
+#endif
+#if (WIN_TABLE_LEN % WELCH_SEG_POINTS) != 0
+#error "WELCH_SEG_POINTS must divide WIN_TABLE_LEN"
+#endif
+
+#define WELCH_MIN_BIN     2     // 去均值后 Hann 主瓣仍会覆盖 bin 1
+
+static const float32_t s_WelchBandEdges[WELCH_BAND_NUM + 1] = {
+    10.0f, 100.0f, 250.0f, 500.0f, 1000.0f, 2000.0f, 4000.0f, 8000.0f, 12800.0f
+};
+
+static arm_rfft_fast_instance_f32 S_welchRfft;
+static float32_t welchSeg[WELCH_SEG_POINTS];            // 加窗段 / 复数谱 / 帧结束时的排序缓冲
+static float32_t welchPsd[WELCH_SEG_POINTS / 2 + 1];    // 平均功率谱 g²/Hz，bin k = k*fs/段长
+static const q15_t *s_welchWin;                         // Hann 半窗 (Flash 表，步长 WIN_TABLE_LEN / 段长)
+static float32_t s_welchWinPow;                         // Σw²
+static uint32_t  s_welchSegs;                           // 已平均段数
+static uint32_t  s_welchFill;                           // 复位后连续到达的点数 (到 WELCH_HOP 为止)
+static const int16_t *s_welchPrev;                      // 上一个半段起点，NULL = 尚无
+static volatile uint8_t s_welchReady = 0;               // Calc_Init 在 AlgoTask 中执行，之前不累加
+static WelchResult_t s_WelchFrame[FRAME_POOL_SLOTS];    // 已完成帧 (按帧槽位)
+static WelchResult_t s_WelchOut;                        // 最近一次发布的结果
+
+static void Welch_Init(void)
+{
+    arm_rfft_fast_init_f32(&S_welchRfft, WELCH_SEG_POINTS);
+    s_welchWin = g_WinInfo[WIN_HANN].half;
+    s_welchWinPow = g_WinInfo[WIN_HANN].pg * (float32_t)WELCH_SEG_POINTS;
+    Welch_Reset();
+    s_welchReady = 1;
+}
+
+void Welch_Reset(void)
+{
+    s_welchSegs = 0;
+    Welch_MarkGap();
+}
+
+// 采样不连续 (FIFO 溢出/DMA 超时): 段不跨越缺口，已平均的段保留
+void Welch_MarkGap(void)
+{
+    s_welchFill = 0;
+    s_welchPrev = NULL;
+}
+
+// 一段: pPrev/pCur 为 Z 轴平面上两个相邻半段，各 WELCH_HOP 个采样
+static void Welch_Segment(const int16_t *pPrev, const int16_t *pCur)
+{
+    int32_t sum = Raw_Sum(pPrev, WELCH_HOP) + Raw_Sum(pCur, WELCH_HOP);
+    float32_t mean = (float32_t)sum / (float32_t)WELCH_SEG_POINTS;
+
+    const uint32_t stride = WIN_TABLE_LEN / WELCH_SEG_POINTS;
+    for (uint32_t i = 0; i < WELCH_HOP; i++) {
+        float32_t wa = (float32_t)s_welchWin[i * stride] * WIN_Q15_SCALE;
+        float32_t wb = (float32_t)s_welchWin[(WELCH_HOP - i) * stride] * WIN_Q15_SCALE;
+        welchSeg[i]             = ((float32_t)pPrev[i] - mean) * wa;
+        welchSeg[WELCH_HOP + i] = ((float32_t)pCur[i] - mean) * wb;
+    }
+
+    Rfft_Forward_InPlace(&S_welchRfft, welchSeg);
+    float32_t dc = welchSeg[0], nyq = welchSeg[1];
+    arm_cmplx_mag_squared_f32(welchSeg, welchSeg, WELCH_HOP);   // 顺序读 2 写 1，可原位
+    welchSeg[0] = 0.5f * dc * dc;                               // DC / Nyquist 不折叠
+    welchSeg[WELCH_HOP] = 0.5f * nyq * nyq;
+
+    // 单边 PSD = 2|X|² / (fs Σw²)，LSB² 换算为 g²
+    float32_t fs = (g_cfg_freq_hz != 0) ? (float32_t)g_cfg_freq_hz : SAMPLE_FREQ;
+    float32_t scale = 2.0f * KX134_SENSITIVITY * KX134_SENSITIVITY / (fs * s_welchWinPow);
+
+    s_welchSegs++;
+    float32_t alpha = 1.0f / (float32_t)s_welchSegs;
+#if WELCH_AVG_MODE == WELCH_AVG_EXP
+    if (s_welchSegs > WELCH_EXP_SEGS) alpha = 1.0f / (float32_t)WELCH_EXP_SEGS;
+#endif
+    for (uint32_t k = 0; k <= WELCH_HOP; k++) {
+        welchPsd[k] += alpha * (welchSeg[k] * scale - welchPsd[k]);
+    }
+}
+
+// DataTask 每读完一块调用 (长度任意，不跨越帧)。半段固定在缓冲内 WELCH_HOP 对齐处，
+// 块写满某个半段的末尾时处理该半段 (WELCH_HOP 整除 FFT_POINTS，半段不会跨越帧)
+void Welch_AccumulateBlock(const int16_t *pFrame, uint32_t offset, uint32_t count)
+{
+    if (!s_welchReady) return;
+
+    const int16_t *pZ = RAW_AXIS(pFrame, 2);
+    uint32_t start = offset;
+    uint32_t end = start + count;
+
+    for (uint32_t e = (start / WELCH_HOP + 1) * WELCH_HOP; e <= end; e += WELCH_HOP) {
+        // 上电或复位后的第一个不完整半段丢弃
+        if (s_welchFill + (e - start) < WELCH_HOP) continue;
+        const int16_t *pHalf = pZ + (e - WELCH_HOP);
+        if (s_welchPrev != NULL) {
+            Welch_Segment(s_welchPrev, pHalf);
+        }
+        s_welchPrev = pHalf;
+    }
+    if (s_welchFill < WELCH_HOP) s_welchFill += count;   // 复位后连续到达的点数，够一个半段即可
+}
+
+// 峰值 bin 及左右各 1 bin 的功率折算为正弦幅值: Σ PSD*df = A²/2 (Hann 下至少含 98% 主瓣功率)
+static float32_t Welch_ToneAmp(uint32_t k, float32_t df)
+{
+    float32_t pow = welchPsd[k - 1] + welchPsd[k] + welchPsd[k + 1];
+    return sqrtf(2.0f * pow * df);
+}
+
+// 一帧采集完成: 由平均谱求频带能量与主峰，写入该帧槽位 (DataTask 中执行，welchSeg 此时空闲)
+void Welch_FinishFrame(uint8_t slot)
+{
+    WelchResult_t *r = &s_WelchFrame[slot];
+    float32_t floor[(WELCH_HOP + NF_BAND_BINS - 1) / NF_BAND_BINS];
+
+    memset(r, 0, sizeof(*r));
+    if (!s_welchReady || s_welchSegs == 0) return;
+
+    float32_t fs = (g_cfg_freq_hz != 0) ? (float32_t)g_cfg_freq_hz : SAMPLE_FREQ;
+    float32_t df = fs / (float32_t)WELCH_SEG_POINTS;
+    float32_t total = 0.0f;
+    uint32_t b = 0;
+
+    r->segs = (s_welchSegs > 0xFFFFu) ? 0xFFFFu : (uint16_t)s_welchSegs;
+    for (uint32_t k = 1; k <= WELCH_HOP; k++) {
+        float32_t e = welchPsd[k] * df;
+        float32_t f = (float32_t)k * df;
+        total += e;
+        while (b < WELCH_BAND_NUM && f >= s_WelchBandEdges[b + 1]) b++;
+        if (b < WELCH_BAND_NUM && f >= s_WelchBandEdges[b]) r->band[b] += e;
+    }
+    r->rms = sqrtf(total);
+    for (b = 0; b < WELCH_BAND_NUM; b++) {
+        if (s_WelchBandEdges[b] >= 0.5f * fs) r->band[b] = -1.0f;   // 整个频带在 ODR/2 以上
+    }
+
+    // 噪声底: 与单帧谱相同的分带中位数。单段功率门限为 NF_SNR_RATIO²，
+    // K 段平均后估计的标准差降为 1/√K，门限超出均值的部分按同样比例收缩
+    for (uint32_t i = 0; i * NF_BAND_BINS < WELCH_HOP; i++) {
+        uint32_t start = i * NF_BAND_BINS;
+        uint32_t n = (WELCH_HOP - start < NF_BAND_BINS) ? (WELCH_HOP - start) : NF_BAND_BINS;
+        memcpy(welchSeg, &welchPsd[start], n * sizeof(float32_t));
+        floor[i] = Select_Kth(welchSeg, n, n * NF_PERCENTILE / 100);
+    }
+
+    uint32_t kEff = s_welchSegs;
+#if WELCH_AVG_MODE == WELCH_AVG_EXP
+    if (kEff > WELCH_EXP_SEGS) kEff = WELCH_EXP_SEGS;
+#endif
+    float32_t ratio = 1.0f + (NF_SNR_RATIO * NF_SNR_RATIO - 1.0f) / sqrtf((float32_t)kEff);
+
+    uint32_t peak = 0;
+    float32_t maxPsd = 0.0f;
+    for (uint32_t k = WELCH_MIN_BIN; k < WELCH_HOP - 1; k++) {
+        float32_t gate = floor[k / NF_BAND_BINS] * ratio;
+        if (welchPsd[k] > maxPsd && welchPsd[k] >= gate) {
+            maxPsd = welchPsd[k];
+            peak = k;
+        }
+    }
+
+    if (peak != 0) {
+        float32_t amp = Welch_ToneAmp(peak, df);
+        if (amp >= NF_ABS_MIN_AMP) {
+            // Hann 主瓣近似高斯，对数域抛物线插值
+            float32_t a = welchPsd[peak - 1], c = welchPsd[peak + 1];
+            float32_t delta = 0.0f;
+            if (a > 0.0f && c > 0.0f) {
+                float32_t la = logf(a), lb = logf(maxPsd), lc = logf(c);
+                float32_t den = 2.0f * lb - la - lc;
+                if (den > 0.0f) delta = 0.5f * (lc - la) / den;
+            }
+            r->peakFreq = ((float32_t)peak + delta) * df;
+            r->peakAmp  = amp;
+
+            uint32_t k2 = (uint32_t)(2.0f * ((float32_t)peak + delta) + 0.5f);
+            if (k2 < WELCH_HOP) r->amp2x = Welch_ToneAmp(k2, df);
+        }
+    }
+
+#if WELCH_AVG_MODE == WELCH_AVG_LINEAR
+    s_welchSegs = 0;
+#endif
+}
+
+// AlgoTask 处理完 slot 后调用: 发布 Welch 结果 (CMD_PSD)，Z_data 保持整帧 FFT 的结果
+void Welch_Publish(uint8_t slot)
+{
+    const WelchResult_t *r = &s_WelchFrame[slot];
+    if (r->segs == 0) return;
+
+    taskENTER_CRITICAL();
+    s_WelchOut = *r;
+    taskEXIT_CRITICAL();
+}
+#endif /* ALGO_WELCH_PSD */
+
+void Algo_Get_Welch(WelchResult_t *out)
+{
+#if ALGO_WELCH_PSD
+    taskENTER_CRITICAL();
+    *out = s_WelchOut;
+    taskEXIT_CRITICAL();
+#else
+    memset(out, 0, sizeof(*out));
+    out->segs = WELCH_SEGS_NA;
+#endif
+}
 
 /*void print_FEATURE(void)
 {
@@ -265,64 +1719,62 @@ static void Calc_Envelope_Stats(float32_t *env_data, uint32_t len, AxisFeatureVa
     printf("         2x Amp    = %.4f g\r\n", Z_data.amp2x);
     printf("[Z-Enve] Env Vrms  = %.3f g     Env Peak = %.3f g\r\n", 
            Z_data.envelope_vrms, Z_data.envelope_peak);
+    printf("[Z-Integ] Vel RMS(10-1k) = %.3f mm/s  Disp P-P = %.2f um\r\n",
+           Z_data.vel_rms_iso, Z_data.disp_pp);
+    printf("[X-Freq] Main Freq = %5.1f Hz   Peak Amp = %.4f g   2x Amp = %.4f g\r\n",
+           X_data.peakFreq, X_data.peakAmp, X_data.amp2x);
+    printf("[Y-Freq] Main Freq = %5.1f Hz   Peak Amp = %.4f g   2x Amp = %.4f g\r\n",
+           Y_data.peakFreq, Y_data.peakAmp, Y_data.amp2x);
+    for (uint32_t n = 0; n < ENV_PEAK_NUM; n++) {
+        printf("[Z-EnvSpec] #%u  %7.2f Hz  %.4f g\r\n", (unsigned)n,
+               Z_data.env_peak_freq[n], Z_data.env_peak_amp[n]);
+    }
     printf("===============================================\r\n\n");
 }*/
 	
-void Process_Data(int16_t *pRawData)
+void Process_Data(int16_t *pRawData, const StreamAxisAcc_t *pStream)
 {	  
-    for (int i = 0; i < FFT_POINTS; i++) {
-        // 解交错 + 转换 float + 物理量变换
-        fftBuf[i] = (float)pRawData[i * 3 + 0] * KX134_SENSITIVITY;
-    }        
-    Calc_TimeDomain_Only(fftBuf, FFT_POINTS, &X_data);
-    Remove_DC(fftBuf, FFT_POINTS);   
-    Integrate_Acc_To_Vel(fftBuf, FFT_POINTS);       
-    Calc_RMS_Only(fftBuf, FFT_POINTS, &X_data);
-
-    // --- 处理 Y 轴 ---
-    for (int i = 0; i < FFT_POINTS; i++) {
-        fftBuf[i] = (float)pRawData[i * 3 + 1] * KX134_SENSITIVITY;
-    }
-    Calc_TimeDomain_Only(fftBuf, FFT_POINTS, &Y_data);
-    Remove_DC(fftBuf, FFT_POINTS);       
-    Integrate_Acc_To_Vel(fftBuf, FFT_POINTS);       
-    Calc_RMS_Only(fftBuf, FFT_POINTS, &Y_data);
-
-    // --- 处理 Z 轴 (含频域) ---
-    for (int i = 0; i < FFT_POINTS; i++) {
-        float val = (float)pRawData[i * 3 + 2] * KX134_SENSITIVITY;
-        fftBuf[i] = val;
-        //g_WaveZ_Live[i] = val;
-    }
-    Calc_TimeDomain_Only(fftBuf, FFT_POINTS, &Z_data);
+    uint32_t t0 = DWT->CYCCNT;
+
+    s_Win = &g_WinInfo[(g_cfg_window < WIN_TYPE_NUM) ? g_cfg_window : WIN_DEFAULT];
+#if ALGO_FIXED_POINT
+    (void)pStream;
+    Process_Data_Q15(pRawData);
+#else
+    if (pStream != NULL) {
+        Stage_FromStream(pStream);
+    } else {
+        Stage_Convert(pRawData, FFT_POINTS);
+    }
+    Stage_Centered(pRawData, FFT_POINTS, fftBuf, pStream == NULL);   // fftBuf = Z 轴去直流加窗信号
+    Stage_Velocity(pRawData, FFT_POINTS);
+
+    Stage_Finalize(&s_Stage[0], FFT_POINTS, &X_data);
+    Stage_Finalize(&s_Stage[1], FFT_POINTS, &Y_data);
+    Stage_Finalize(&s_Stage[2], FFT_POINTS, &Z_data);
     Z_data.mean =  Z_data.mean - 1;
-    Remove_DC(fftBuf, FFT_POINTS);
-    //Apply_Median_Filter_3(fftBuf, FFT_POINTS);
-    //快照
+
+    // 包络 (去直流后整流)
+    Z_data.envelope_vrms = sqrtf(s_Stage[2].envSumSq / (float32_t)FFT_POINTS);
+    Z_data.envelope_peak = s_Stage[2].envMax;
+
+    //快照 (原始采样 + 直流分量，去直流在发送时完成)
     if (g_SnapshotReq == 1) {
+        const float32_t zMean = s_Stage[2].mean * KX134_SENSITIVITY_LSB_G;
         taskENTER_CRITICAL();
-        memcpy(g_WaveZ_Tx, fftBuf, FFT_POINTS * sizeof(float));
+        memcpy(g_WaveZ_Tx, RAW_AXIS(pRawData, 2), sizeof(g_WaveZ_Tx));
+        g_WaveZ_Mean = zMean;
         taskEXIT_CRITICAL();
         g_SnapshotReq = 0; 
     }
+    Calc_Envelope_Z(pRawData, s_Stage[2].mean, FFT_POINTS, &Z_data);
     Calc_FreqDomain_Z(fftBuf, FFT_POINTS, &Z_data);
+    Calc_FreqDomain_XY(pRawData, fftBuf, FFT_POINTS);   // Z 频域处理完后复用 fftBuf
+#endif
 
-    for (int i = 0; i < FFT_POINTS; i++) {
-        fftBuf[i] = (float)pRawData[i * 3 + 2] * KX134_SENSITIVITY;
-    }
-    Remove_DC(fftBuf, FFT_POINTS);       
-    //Apply_Median_Filter_3(fftBuf, FFT_POINTS); // 去毛刺
-    Integrate_Acc_To_Vel(fftBuf, FFT_POINTS);       // 积分为速度
-    Calc_RMS_Only(fftBuf, FFT_POINTS, &Z_data); // 覆盖为速度 RMS
-
-    //fftbuf为频谱数据
-    for (int i = 0; i < FFT_POINTS; i++) {
-        // 再次从源头读取
-        float val = (float)pRawData[i * 3 + 2] * KX134_SENSITIVITY;
-        fftBuf[i] = val;
-    }
-    Remove_DC_And_Rectify(fftBuf, FFT_POINTS);
-    Calc_Envelope_Stats(fftBuf, FFT_POINTS, &Z_data);
+    uint32_t cycles = DWT->CYCCNT - t0;
+    g_AlgoCycles = cycles;
+    if (cycles > g_AlgoCyclesMax) g_AlgoCyclesMax = cycles;
 }
 
 
@@ -2,6 +2,7 @@
 #define EIGENVALUE_CALCULATION_H_
 #include "main.h"
 #include "arm_math.h"
+#include "window.h"
 
 // ================== 参数定义 ==================
 // KX134-1211 Range +/- 64g
@@ -13,6 +14,28 @@
 // FFT 配置
 #define SAMPLE_FREQ       25600.0f  // 25.6kHz
 
+// FFT 耗时对比: 1 = Calc_Init 时用 DWT 测一次三轴独立 RFFT 与 X/Y 二合一方案 (g_FftBenchCycles)，尚未在板上实测
+#define ALGO_FFT_BENCH           0
+
+// 噪声底耗时对比: 1 = Calc_Init 时用 DWT 测一次快速选择与整段排序求中位数 (g_NfBenchCycles)
+#define ALGO_NF_BENCH            0
+
+// 包络谱: 带通 -> 整流 -> ENV_DECIM 点平均抽取 -> RFFT
+#define ENV_BP_LO_HZ         1000.0f  // 共振带下限
+#define ENV_BP_HI_HZ         8000.0f  // 共振带上限 (超过 0.45*ODR 时自动收窄)
+#define ENV_DECIM            8        // 抽取倍数，25.6kHz 下包络谱上限 1600Hz
+#define ENV_FFT_POINTS       (FFT_POINTS / ENV_DECIM)
+#define ENV_BLOCK            64       // 带通分块长度 (ENV_DECIM 的整数倍)
+#define ENV_PEAK_NUM         3        // 上报的包络谱峰个数
+
+// 频谱峰值表 (Z 轴): 前 N 个局部极大值，插值到亚 bin 精度并标注谐波/边带关系
+#define PEAK_TABLE_N         8
+#define PEAK_COUNT_NA        0xFF     // Algo_Get_PeakTable: 本模式不计算峰值表 (定点模式)
+#define PEAK_TAG_NONE        0
+#define PEAK_TAG_FUND        1        // 基频 (存在以它为基的谐波)
+#define PEAK_TAG_HARMONIC    2        // 谐波，ref = 基频序号
+#define PEAK_TAG_SIDEBAND    3        // 边带，ref = 载波序号
+
 // ================== 数据结构 ==================
 typedef struct
 {
@@ -25,17 +48,109 @@ typedef struct
 		float amp2x;							 // 2x转频幅值（4字节）
     float envelope_vrms;       // 包络有效值（4字节）
     float envelope_peak;       // 包络峰值（4字节）
+    float vel_rms_iso;         // 频域积分速度 RMS，ISO 频带 10~1000Hz，mm/s（4字节，仅 Z）
+    float disp_pp;             // 频域积分位移峰峰值，um（4字节，仅 Z）
+    float env_peak_freq[ENV_PEAK_NUM];  // 包络谱前 N 个峰频率，Hz（仅 Z）
+    float env_peak_amp[ENV_PEAK_NUM];   // 包络谱前 N 个峰幅值，g（仅 Z）
 } AxisFeatureValue;
+
+// 频域积分 (ω 算术): 速度 = A/(jω)，位移 = -A/ω²
+#define INTEG_BAND_LO_HZ     10.0f    // ISO 10816 速度频带下限
+#define INTEG_BAND_HI_HZ     1000.0f  // ISO 10816 速度频带上限
+#define INTEG_HP_CORNER_HZ   10.0f    // 位移积分高通拐点 (二阶 Butterworth 幅频，零相位)
+
+// 定点模式: 1 = 时域整数累加 + q15 FFT (fftBuf 由 16KB float 变为 8KB q15)，0 = float32 路径
+#define ALGO_FIXED_POINT         0
+#define ALGO_NA_VALUE            (-1.0f)  // 本模式不计算的 float 输出 (定点模式: X/Y 频谱、包络谱峰)
+
+// 流式累加模式: 1 = DataTask 每个 FIFO 水位块累加时域统计量，AlgoTask 帧结束时只做收尾
+// (定点模式的时域统计本身是整数精确累加，不使用流式累加)
+#if ALGO_FIXED_POINT
+#define ALGO_STREAM_TIMEDOMAIN   0
+#else
+#define ALGO_STREAM_TIMEDOMAIN   1
+#endif
+
+// Welch 平均功率谱 (Z 轴): 1 = DataTask 每凑满半段做一次加窗 RFFT 并累加到平均谱 (g²/Hz)，
+// 帧结束时给出主峰与频带能量，经 CMD_PSD 单独上报；Z_data 的特征值仍用整帧 FFT
+#if ALGO_FIXED_POINT
+#define ALGO_WELCH_PSD           0
+#else
+#define ALGO_WELCH_PSD           1
+#endif
+#define WELCH_SEG_POINTS     1024     // 段长 (2 的幂，256~4096)，分辨率 = ODR / 段长
+#define WELCH_HOP            (WELCH_SEG_POINTS / 2)   // 50% 重叠，须整除 FFT_POINTS
+#define WELCH_AVG_LINEAR     0        // 帧内各段线性平均，每帧重新开始
+#define WELCH_AVG_EXP        1        // 跨段跨帧指数平均，α = 1/WELCH_EXP_SEGS
+#define WELCH_AVG_MODE       WELCH_AVG_LINEAR
+#define WELCH_EXP_SEGS       32       // 指数平均的等效段数
+#define WELCH_BAND_NUM       8        // 频带能量个数，边界见 s_WelchBandEdges
+#define WELCH_SEGS_NA        0xFFFF   // WelchResult_t.segs: 未启用 Welch (定点模式)
+
+typedef struct
+{
+    uint16_t segs;                    // 本结果平均的段数，0 = 无效
+    float    peakFreq;                // 主峰频率 Hz (高斯插值)
+    float    peakAmp;                 // 主峰幅值 g (主瓣内功率折算)
+    float    amp2x;                   // 2 倍主峰频率处幅值 g
+    float    rms;                     // 全频带 RMS g (不含直流)
+    float    band[WELCH_BAND_NUM];    // 各频带能量 g² (均方值)，频带在 ODR/2 以上时为 -1
+} WelchResult_t;
+
+typedef struct
+{
+    float   freq;          // 插值后频率 Hz
+    float   amp;           // 修正后幅值 g
+    uint8_t tag;           // PEAK_TAG_xxx
+    uint8_t ref;           // 谐波/边带所关联峰在表中的序号
+    uint8_t order;         // 谐波次数 (仅 PEAK_TAG_HARMONIC)
+} SpecPeak_t;
+
+// 单轴流式累加量
+typedef struct
+{
+    uint32_t  n;           // 已累加点数
+    float32_t mean;        // 运行均值
+    float32_t M2;          // 二阶中心矩 (Σ(x-u)^2)
+    float32_t M3;          // 三阶中心矩 (合并 M4 需要)
+    float32_t M4;          // 四阶中心矩
+    float32_t sum;         // Σx
+    float32_t sumSq;       // Σx^2
+    float32_t minVal;
+    float32_t maxVal;
+} StreamAxisAcc_t;
 extern AxisFeatureValue X_data,Y_data,Z_data;
 extern float g_z_offset_g;
 extern volatile uint8_t g_SnapshotReq;    
+extern volatile uint32_t g_AlgoCycles;     // 最近一帧 Process_Data 耗时 (DWT 周期)
+extern volatile uint32_t g_AlgoCyclesMax;  // 历史最大耗时
+#if ALGO_FFT_BENCH
+extern volatile uint32_t g_FftBenchCycles[2];
+#endif
+#if ALGO_NF_BENCH
+extern volatile uint32_t g_NfBenchCycles[2];
+#endif
 //extern float g_WaveZ_Live[FFT_POINTS]; // 实时更新区 (算法写)
 //extern float g_WaveZ_Tx[FFT_POINTS];
 
 void Calc_Init(void);// 用于在上电时调用一次，负责 FFT 表初始化和滤波器初始化
-void Process_Data(int16_t *pRawData);
+void Calc_SetFrameConfig(uint16_t fs, uint8_t flags);   // AlgoTask 在 Process_Data 前按帧的采样率与 ACQ_FLAG_xxx 调用
+void Process_Data(int16_t *pRawData, const StreamAxisAcc_t *pStream); // pRawData 为按轴分平面的一帧 (RAW_AXIS)，pStream 为 NULL 时整帧计算时域统计
+void Stream_Reset(void);
+void Stream_AccumulateBlock(const int16_t *pFrame, uint32_t offset, uint32_t count);   // 帧内 [offset, offset+count) 刚写入
+void Stream_FinishFrame(uint8_t slot);
+const StreamAxisAcc_t* Stream_GetFrame(uint8_t slot);
 void print_FEATURE();
 void Create_Wave_Snapshot(void);
-const float* Algo_Get_Snapshot_Ptr(void);															
+const int16_t* Algo_Get_Snapshot_Ptr(float *mean_lsb);   // Z 轴原始采样快照，mean_lsb 返回其直流分量 (LSB)
+uint8_t Algo_Get_PeakTable(SpecPeak_t *out);   // 拷贝最近一帧峰值表，返回有效个数 (定点模式为 PEAK_COUNT_NA)
+#if ALGO_WELCH_PSD
+void Welch_Reset(void);
+void Welch_MarkGap(void);
+void Welch_AccumulateBlock(const int16_t *pFrame, uint32_t offset, uint32_t count);
+void Welch_FinishFrame(uint8_t slot);
+void Welch_Publish(uint8_t slot);               // AlgoTask 处理完该槽位后调用
+#endif
+void Algo_Get_Welch(WelchResult_t *out);        // 拷贝最近一帧 Welch 结果 (未启用时 segs = WELCH_SEGS_NA)															
 
 #endif /* EIGENVALUE_CALCULATION_H_ */
@@ -5,6 +5,29 @@
 
 extern TaskHandle_t DataTaskHandle;
 
+volatile uint32_t g_AcqLatencyCycles = 0;
+volatile uint32_t g_AcqLatencyMax    = 0;
+volatile uint32_t g_AcqCpuCycles     = 0;
+volatile uint32_t g_AcqCpuMax        = 0;
+static volatile uint32_t s_tIrq;          // 水位中断时刻
+static uint32_t s_cpuStart;               // 启动传输占用的周期
+
+#if KX134_DRAIN_FULL_DUPLEX
+// 全双工: MOSI 依次发出 [0xE3, 0, 0, ...]，MISO 第 1 字节是命令期间的无效数据，
+// 真正的 FIFO 数据从 s_FifoRx[1] 开始。长度 1 + 6n 为奇数，不能改用 16 位帧 (会多读 FIFO 1 字节)。
+// 发送缓冲为常量放在 Flash (DMA2 可直接读)。
+static const uint8_t s_FifoTx[1 + KX134_FIFO_MAX_BYTES] = { KX134_BUF_READ | 0x80 };
+#endif
+// DMA 收到暂存区 (两种方式的 FIFO 数据都从 s_FifoRx[1] 开始)，完成中断里按轴拆分到目标平面
+static uint8_t s_FifoRx[1 + KX134_FIFO_MAX_BYTES];
+static int16_t *s_FifoTarget;             // X 平面写入位置
+static uint8_t  s_Res8 = 0;               // 1 = 8 位缓冲模式
+static uint8_t  s_SampleBytes = BYTES_PER_SAMPLE;
+static uint16_t s_FifoCapacity = KX134_FIFO_MAX_SAMPLES;
+static uint32_t s_FifoStride;             // 平面间距 (采样)
+static KX134_Adp_t s_Adp = { KX134_ADP_OFF, 0, 0 };
+static uint16_t s_FifoSamples;            // 本次读取的采样数
+
 static uint8_t KX134_FreqToHex(uint16_t freq) {
     uint8_t odr_setting = 0x0F; // 默认最高
 
@@ -47,6 +70,32 @@ uint8_t KX134_ReadReg(uint8_t Reg) {
     return rx_data;
 }
 
+// 缓冲区中的完整采样数 (BUF_STATUS_1/2 连读，SMP_LEV 单位为字节)
+uint16_t KX134_FIFO_Samples(void) {
+    uint8_t tx[3] = { KX134_BUF_STATUS_1 | 0x80, 0x00, 0x00 };
+    uint8_t rx[3];
+    HAL_GPIO_WritePin(KX134_CS_GPIO_Port, KX134_CS_Pin, GPIO_PIN_RESET);
+    HAL_SPI_TransmitReceive(&hspi1, tx, rx, 3, 10);
+    HAL_GPIO_WritePin(KX134_CS_GPIO_Port, KX134_CS_Pin, GPIO_PIN_SET);
+
+    uint16_t bytes = (uint16_t)(((rx[2] & 0x03) << 8) | rx[1]);
+    uint16_t samples = bytes / s_SampleBytes;
+    if (samples > s_FifoCapacity) samples = s_FifoCapacity;
+    return samples;   // 已满时 Stream 模式下最旧的采样已被覆盖，由调用方计数
+}
+
+uint16_t KX134_FIFO_Capacity(void) {
+    return s_FifoCapacity;
+}
+
+// 水位 = ODR / FIFO_WMI_PERIOD_HZ，不同 ODR 下中断间隔大致相同
+static uint8_t KX134_WatermarkForODR(uint16_t freq) {
+    uint16_t wm = freq / FIFO_WMI_PERIOD_HZ;
+    if (wm > FIFO_WATERMARK) wm = FIFO_WATERMARK;
+    if (wm < FIFO_WATERMARK_MIN) wm = FIFO_WATERMARK_MIN;
+    return (uint8_t)wm;
+}
+
 //uint8_t KX134_ReadReg(uint8_t Reg) {
 //    uint8_t tx_data[2];
 //    uint8_t rx_data[2];
@@ -108,10 +157,10 @@ uint8_t KX134_Init(void) {
     KX134_WriteReg(KX134_BUF_CNTL1, FIFO_WATERMARK); 
     
     // 7. 开启 FIFO (Stream Mode)
-    //  BUF_CNTL2 0xE0 = BUFE(1)|BRES(1)|BFIE(1)|BM(0)
+    //  BUF_CNTL2 0xE0 = BUFE(1)|BRES(1)|BFIE(1)|BM(0)，8 位模式 BRES = 0 (0xA0)
     // 注意：这里我们只要 Buffer Enable 和 Resolution，中断已经在 INC4 映射了 WMI
     // 但 BFIE 位通常控制的是 "Buffer相关的中断总开关"，所以设为 1 是对的
-    KX134_WriteReg(KX134_BUF_CNTL2, 0xE0);
+    KX134_WriteReg(KX134_BUF_CNTL2, s_Res8 ? KX134_BUF_CNTL2_8BIT : KX134_BUF_CNTL2_16BIT);
     
     // 8. 启动传感器
     // [cite: 51] CNTL1 0xC0 是 +/-8g.
@@ -127,27 +176,162 @@ uint8_t KX134_Init(void) {
     return 1;
 }
 
-void KX134_Read_FIFO_DMA(uint8_t *target_buffer) {
+void KX134_Read_FIFO_DMA(int16_t *pX, uint32_t planeStride, uint16_t samples) {
+    uint32_t t0 = DWT->CYCCNT;
+    HAL_StatusTypeDef status;
+
+    if (samples > s_FifoCapacity) samples = s_FifoCapacity;
+    s_FifoSamples = samples;
+    s_FifoTarget = pX;
+    s_FifoStride = planeStride;
+
     HAL_GPIO_WritePin(KX134_CS_GPIO_Port, KX134_CS_Pin, GPIO_PIN_RESET);
-    
+
     // [cite: 206] 规格书 Page 9 强调要用 Repeated Start 或者直接读
     // 对于 DMA，最简单的是发送寄存器地址后直接通过 SPI 时钟读数据
     // KX134_BUF_READ (0x63) | 0x80 = 0xE3
+#if KX134_DRAIN_FULL_DUPLEX
+    status = HAL_SPI_TransmitReceive_DMA(&hspi1, (uint8_t *)s_FifoTx, s_FifoRx, 1 + samples * s_SampleBytes);
+#else
     uint8_t cmd = KX134_BUF_READ | 0x80;
     HAL_SPI_Transmit(&hspi1, &cmd, 1, 10);
-    
-		HAL_StatusTypeDef status = HAL_SPI_Receive_DMA(&hspi1, target_buffer, FIFO_WATERMARK * 6);		
-		if (status != HAL_OK) {
-					// Error_Handler(); 
-					// 查看 hspi1.ErrorCode
-			}
+    status = HAL_SPI_Receive_DMA(&hspi1, &s_FifoRx[1], samples * s_SampleBytes);
+#endif
+    if (status != HAL_OK) {
+        // 查看 hspi1.ErrorCode；DataTask 等信号量超时后调用 KX134_FIFO_Abort
+    }
+    s_cpuStart = DWT->CYCCNT - t0;
+}
+
+void KX134_FIFO_IrqStamp(void) {
+    s_tIrq = DWT->CYCCNT;
+}
+
+void KX134_FIFO_DMA_Cplt(void) {
+    uint32_t t0 = DWT->CYCCNT;
+
+    HAL_GPIO_WritePin(KX134_CS_GPIO_Port, KX134_CS_Pin, GPIO_PIN_SET);
+
+    // 解交错: [XL XH YL YH ZL ZH] x n -> X/Y/Z 三个连续平面 (暂存区从奇地址开始，按字节拼)
+    const uint8_t *src = &s_FifoRx[1];
+    int16_t *px = s_FifoTarget;
+    int16_t *py = px + s_FifoStride;
+    int16_t *pz = py + s_FifoStride;
+    if (s_Res8) {
+        // 8 位: [XH YH ZH] 放到高字节 (q7 -> q15)，帧格式与灵敏度不变，低 8 位为 0
+        for (uint32_t i = 0; i < s_FifoSamples; i++) {
+            px[i] = (int16_t)(src[0] << 8);
+            py[i] = (int16_t)(src[1] << 8);
+            pz[i] = (int16_t)(src[2] << 8);
+            src += BYTES_PER_SAMPLE_8BIT;
+        }
+    } else {
+        for (uint32_t i = 0; i < s_FifoSamples; i++) {
+            px[i] = (int16_t)(src[0] | (src[1] << 8));
+            py[i] = (int16_t)(src[2] | (src[3] << 8));
+            pz[i] = (int16_t)(src[4] | (src[5] << 8));
+            src += BYTES_PER_SAMPLE;
+        }
+    }
+
+    uint32_t t1 = DWT->CYCCNT;
+    uint32_t lat = t1 - s_tIrq;
+    uint32_t cpu = s_cpuStart + (t1 - t0);
+    g_AcqLatencyCycles = lat;
+    if (lat > g_AcqLatencyMax) g_AcqLatencyMax = lat;
+    g_AcqCpuCycles = cpu;
+    if (cpu > g_AcqCpuMax) g_AcqCpuMax = cpu;
+}
+
+void KX134_FIFO_Abort(void) {
+    HAL_SPI_Abort(&hspi1);
+    HAL_GPIO_WritePin(KX134_CS_GPIO_Port, KX134_CS_Pin, GPIO_PIN_SET);
+    // 中断的突发读可能停在采样中间，之后的读取会错位，直接清空重新开始
+    KX134_WriteReg(KX134_BUF_CLEAR, 0x00);
+}
+
+void KX134_FIFO_Clear(void) {
+    KX134_WriteReg(KX134_BUF_CLEAR, 0x00);
 }
 
 void KX134_CS_High(void) {
     HAL_GPIO_WritePin(KX134_CS_GPIO_Port, KX134_CS_Pin, GPIO_PIN_SET);
 }
 
-uint8_t KX134_SetODR(uint16_t freq_hz) {
+/* ADP 滤波器定点模型 (k = tan(π·fc/ODR)，双线性变换的 Butterworth):
+ *   Filter-1 低通: A·y[n] = x[n] + 2x[n-1] + x[n-2] - B·y[n-1] - C·y[n-2]
+ *                  A = (1 + √2k + k²)/k²，B = 2(k² - 1)/k²，C = (1 - √2k + k²)/k²
+ *                  F1_1A = 1/A · 2^(7+ISH) (ISH 使其落在 64~127)，F1_BA/F1_CA = B/A、C/A · 2^21 (23 位补码)
+ *   Filter-2 高通: A·y[n] = x[n] - x[n-1] - B·y[n-1]，A = 1 + k，B = k - 1
+ *                  F2_1A = 1/A · 2^7，F2_BA = -B/A · 2^15
+ * 两级通带增益均为 1 (高通截止低于 ODR/800 时 F2_1A 饱和在 127，增益误差 < 1%)，OSH 取 0。
+ * 系数随 ODR 变化，须与 ODCNTL 在同一次待机内写入。
+ * 参考值 (主机上用同一算式算出，按寄存器值解码后的响应: 通带增益 1±0.7%，fc 处 -3±0.05 dB):
+ *   LPF ODR 25600 fc 5000: CNTL3=66 CNTL4..6=76 0E 73 CNTL7..9=AE 6B 06 CNTL10=02
+ *   LPF ODR 25600 fc 1000: CNTL3=69 CNTL4..6=43 05 4B CNTL7..9=C1 9D 16 CNTL10=06
+ *   LPF ODR  1600 fc  100: CNTL3=7B CNTL4..6=D6 76 51 CNTL7..9=B7 5E 12 CNTL10=05
+ *   HPF ODR 25600 fc   10: CNTL11=7F CNTL12..13=B0 7F
+ *   HPF ODR  1600 fc   10: CNTL11=7E CNTL12..13=12 7B
+ * 已知限制: 以上只验证了算式与编码自洽，定点格式 (位宽、ISH 含义、BA/CA 符号) 按数据手册理解，
+ * 尚未与 Kionix ADP 系数计算器或实测响应核对，核对前 KX134_ADP_ENABLE = 0，这里只走关闭分支 */
+static void KX134_AdpWrite(uint16_t freq_hz, const KX134_Adp_t *adp)
+{
+    uint8_t cntl5 = KX134_ReadReg(KX134_CNTL5) & (uint8_t)~KX134_CNTL5_ADPE;
+    if (adp->mode == KX134_ADP_OFF || !KX134_ADP_ENABLE) {
+        KX134_WriteReg(KX134_ADP_CNTL2, 0x00);
+        KX134_WriteReg(KX134_CNTL5, cntl5);
+        return;
+    }
+
+    float fs = (float)freq_hz;
+    uint8_t cntl2 = KX134_ADP_BUF_SEL;
+    if (adp->mode == KX134_ADP_RMS) cntl2 |= KX134_ADP_RMS_OSEL;
+
+    if (adp->lpf_hz == 0 || adp->lpf_hz > KX134_ADP_FC_MAX_RATIO * fs) {
+        cntl2 |= KX134_ADP_FLT1_BYP;
+    } else {
+        float k = tanf(PI * (float)adp->lpf_hz / fs);
+        float k2 = k * k;
+        float a = 1.0f + 1.41421356f * k + k2;          // 以 k² 为分母前的 A·k²
+        float inv = k2 / a;                              // 1/A
+        uint8_t ish = 0;
+        while (ish < 24 && inv * (float)(1UL << (7 + ish)) < 63.5f) ish++;
+        uint32_t c1 = (uint32_t)(inv * (float)(1UL << (7 + ish)) + 0.5f);
+        if (c1 > 0x7F) c1 = 0x7F;
+        int32_t ba = (int32_t)lroundf(2.0f * (k2 - 1.0f) / a * 2097152.0f);
+        int32_t ca = (int32_t)lroundf((1.0f - 1.41421356f * k + k2) / a * 2097152.0f);
+        KX134_WriteReg(KX134_ADP_CNTL3, (uint8_t)c1);
+        for (uint8_t i = 0; i < 3; i++) {
+            KX134_WriteReg(KX134_ADP_CNTL4 + i, (uint8_t)(((uint32_t)ba >> (8 * i)) & (i == 2 ? 0x7F : 0xFF)));
+            KX134_WriteReg(KX134_ADP_CNTL7 + i, (uint8_t)(((uint32_t)ca >> (8 * i)) & (i == 2 ? 0x7F : 0xFF)));
+        }
+        KX134_WriteReg(KX134_ADP_CNTL10, ish);
+    }
+
+    uint8_t f2_1a = 0;
+    if (adp->hpf_hz == 0 || adp->hpf_hz > KX134_ADP_FC_MAX_RATIO * fs) {
+        cntl2 |= KX134_ADP_FLT2_BYP;
+    } else {
+        float k = tanf(PI * (float)adp->hpf_hz / fs);
+        uint32_t c1 = (uint32_t)(128.0f / (1.0f + k) + 0.5f);
+        uint32_t ba = (uint32_t)((1.0f - k) / (1.0f + k) * 32768.0f + 0.5f);
+        f2_1a = (uint8_t)(c1 > 0x7F ? 0x7F : c1);
+        if (ba > 0x7FFF) ba = 0x7FFF;
+        KX134_WriteReg(KX134_ADP_CNTL12, (uint8_t)ba);
+        KX134_WriteReg(KX134_ADP_CNTL12 + 1, (uint8_t)(ba >> 8));
+        KX134_WriteReg(KX134_ADP_CNTL18, 0);
+        KX134_WriteReg(KX134_ADP_CNTL19, 0);
+    }
+    KX134_WriteReg(KX134_ADP_CNTL11, f2_1a);          // F1_OSH = 0
+
+    KX134_WriteReg(KX134_ADP_CNTL1, (uint8_t)((KX134_ADP_RMS_AVC << 4) | KX134_FreqToHex(freq_hz)));
+    KX134_WriteReg(KX134_ADP_CNTL2, cntl2);
+    KX134_WriteReg(KX134_CNTL5, cntl5 | KX134_CNTL5_ADPE);
+}
+
+// ODR、缓冲分辨率与 ADP 在同一次待机内切换，只等一次状态切换。
+// 8 位缓冲: 每采样 3 字节，SPI 流量减半，缓冲区可存 171 个采样 (16 位为 86 个)
+uint8_t KX134_Reconfigure(uint16_t freq_hz, uint8_t res8, const KX134_Adp_t *adp) {
     uint8_t odr_val = KX134_FreqToHex(freq_hz);
     
     // 1. 读取 CNTL1 当前值
@@ -157,16 +341,30 @@ uint8_t KX134_SetODR(uint16_t freq_hz) {
     if (ctrl1 & 0x80) {
         KX134_WriteReg(KX134_CNTL1, ctrl1 & 0x7F); 
         // 规格书建议等待一小段时间，确保状态切换
-        vTaskDelay(20); 
+        vTaskDelay(KX134_STANDBY_DELAY_MS); 
     }
     
-    // 3. 写入新的 ODR
+    // 3. 写入新的 ODR，水位随 ODR 调整
     KX134_WriteReg(KX134_ODCNTL, odr_val);
+    KX134_WriteReg(KX134_BUF_CNTL1, KX134_WatermarkForODR(freq_hz));
+    if (adp != &s_Adp) s_Adp = *adp;
+    KX134_AdpWrite(freq_hz, &s_Adp);
+
+    // 4. 重写 BUF_CNTL2 (BRES) 并清空 FIFO，旧配置的采样不会混入新帧
+    s_Res8 = res8 ? 1 : 0;
+    s_SampleBytes = s_Res8 ? BYTES_PER_SAMPLE_8BIT : BYTES_PER_SAMPLE;
+    s_FifoCapacity = s_Res8 ? KX134_FIFO_MAX_SAMPLES_8BIT : KX134_FIFO_MAX_SAMPLES;
+    KX134_WriteReg(KX134_BUF_CNTL2, s_Res8 ? KX134_BUF_CNTL2_8BIT : KX134_BUF_CNTL2_16BIT);
+    KX134_WriteReg(KX134_BUF_CLEAR, 0x00);
     
-    // 4. 恢复之前的模式 (如果是工作模式则恢复为工作模式)
+    // 5. 恢复之前的模式 (如果是工作模式则恢复为工作模式)
     if (ctrl1 & 0x80) {
         KX134_WriteReg(KX134_CNTL1, ctrl1);
     }
     
     return 1;
+}
+
+uint8_t KX134_SetODR(uint16_t freq_hz) {
+    return KX134_Reconfigure(freq_hz, s_Res8, &s_Adp);
 }
\ No newline at end of file
@@ -1,25 +1,83 @@
 #ifndef __APP_ACQ_H__
 #define __APP_ACQ_H__
 
-#include "main.h" 
 #include <stdint.h>
 
-#define FIFO_WATERMARK          64               //水位
+// 高级数据通路 (ADP): 传感器内 Filter-1 二阶低通 -> Filter-2 一阶高通 -> (可选) RMS，
+// ADP_BUF_SEL = 1 时三轴滤波结果代替原始数据进入缓冲区，读取路径、分辨率与灵敏度不变。
+// main.h 中的采集配置引用 KX134_Adp_t，须在包含 main.h 之前定义
+#define KX134_ADP_OFF           0
+#define KX134_ADP_BAND          1                // 带通 (截止为 0 的一级旁路)
+#define KX134_ADP_RMS           2                // 带通后求滑动 RMS，缓冲区中为 RMS 值
+#define KX134_ADP_MODE_NUM      3
+#define KX134_ADP_RMS_AVC       3                // RMS 平均 2^(AVC+1) = 16 点
+#define KX134_ADP_FC_MAX_RATIO  0.45f            // 截止频率上限 (× ODR)，超过则旁路该级
+#define KX134_ADP_ENABLE        0                // 系数编码与数据手册/实测核对前关闭: ADP 配置不应答，Flash 中的配置按关闭处理
+typedef struct {
+    uint8_t  mode;          // KX134_ADP_xxx
+    uint16_t hpf_hz;        // Filter-2 高通截止 (Hz)，0 = 旁路
+    uint16_t lpf_hz;        // Filter-1 低通截止 (Hz)，0 = 旁路
+} KX134_Adp_t;
+
+#include "main.h" 
+
+#define FIFO_WATERMARK          64               //水位 (25.6kHz 时，其他 ODR 见 KX134_SetODR)
+#define FIFO_WATERMARK_MIN      4
+#define FIFO_WMI_PERIOD_HZ      400              // 按 ODR / 400 设水位，各 ODR 下约 2.5ms 一次中断
 #define BYTES_PER_SAMPLE        6                //(X_L, X_H, Y_L, Y_H, Z_L, Z_H)6字节
+#define BYTES_PER_SAMPLE_8BIT   3                // 8 位缓冲模式只存高字节 (X_H, Y_H, Z_H)
+#define KX134_FIFO_MAX_SAMPLES  86               // 16 位模式缓冲区容量 (516 字节)，满后丢最旧数据
+#define KX134_FIFO_MAX_SAMPLES_8BIT 171          // 8 位模式缓冲区容量 (513 字节)
+#define KX134_FIFO_MAX_BYTES    (KX134_FIFO_MAX_SAMPLES * BYTES_PER_SAMPLE)   // 两种模式中较大者
+
+// BUF_CNTL2: BUFE(1)|BRES|BFIE(1)|BM(00 FIFO)，BRES = 1 为 16 位，0 为 8 位
+#define KX134_BUF_CNTL2_16BIT   0xE0
+#define KX134_BUF_CNTL2_8BIT    0xA0
+
+// FIFO 读取方式: 1 = 命令字节与数据在同一次全双工 DMA 中收发，CS 由完成中断拉高，任务不再轮询等待
+//               0 = 旧方式，阻塞发送命令字节后再启动 DMA 接收 (保留用于耗时对比)
+#define KX134_DRAIN_FULL_DUPLEX 1
+
+#define KX134_STANDBY_DELAY_MS  20               // 改 ODR/缓冲配置前进入待机后的等待，决定切换延迟的下限
 
 // ================= 寄存器地址=================
 #define KX134_WHO_AM_I      0x13
 #define KX134_CNTL1         0x1B // [cite: 46]
 #define KX134_CNTL2					0x1C
+#define KX134_CNTL5         0x1F // ADPE = bit4
 #define KX134_ODCNTL        0x21 // [cite: 49]
 #define KX134_INC1          0x22 // [cite: 63]
 #define KX134_INC4          0x25 // [cite: 65]
 #define KX134_BUF_CNTL1     0x5E //  水位设定
 #define KX134_BUF_CNTL2     0x5F //  Buffer控制
+#define KX134_BUF_STATUS_1  0x60 //  缓冲区字节数 SMP_LEV[7:0]
+#define KX134_BUF_STATUS_2  0x61 //  SMP_LEV[9:8] = bit1:0
+#define KX134_BUF_CLEAR     0x62 //  写任意值清空缓冲区
 #define KX134_BUF_READ      0x63 //  数据读取 (Burst Read)
 #define KX134_INT_REL       0x1A // [cite: 291] 中断清除
+#define KX134_ADP_CNTL1     0x64 // RMS_AVC[6:4] | OADP[3:0]
+#define KX134_ADP_CNTL2     0x65 // ADP_BUF_SEL(6) | FLT2_BYP(3) | FLT1_BYP(1) | RMS_OSEL(0)
+#define KX134_ADP_CNTL3     0x66 // F1_1A[6:0]
+#define KX134_ADP_CNTL4     0x67 // F1_BA[7:0]，CNTL5/6 为 [15:8] [22:16]
+#define KX134_ADP_CNTL7     0x6A // F1_CA[7:0]，CNTL8/9 为 [15:8] [22:16]
+#define KX134_ADP_CNTL10    0x6D // F1_ISH[4:0]
+#define KX134_ADP_CNTL11    0x6E // F1_OSH(7) | F2_1A[6:0]
+#define KX134_ADP_CNTL12    0x6F // F2_BA[7:0]，CNTL13 为 [14:8]
+#define KX134_ADP_CNTL18    0x75 // F2_ISH[4:0]
+#define KX134_ADP_CNTL19    0x76 // F2_OSH[4:0]
+#define KX134_CNTL5_ADPE         0x10
+#define KX134_ADP_BUF_SEL        0x40
+#define KX134_ADP_FLT2_BYP       0x08
+#define KX134_ADP_FLT1_BYP       0x02
+#define KX134_ADP_RMS_OSEL       0x01
+
 
 
+// 水位块读取耗时 (DWT 周期，DWT 由 Calc_Init 开启)
+extern volatile uint32_t g_AcqLatencyCycles;    // 最近一块: 水位中断 -> 数据已在目标缓冲
+extern volatile uint32_t g_AcqLatencyMax;
+extern volatile uint32_t g_AcqCpuCycles;        // 最近一块占用的 CPU: 启动传输 + 完成中断
+extern volatile uint32_t g_AcqCpuMax;
 
 extern volatile uint8_t g_acq_complete_flag; // 1 = 采集完成，数据已准备好
 extern volatile uint8_t g_acq_running_flag;  // 1 = 正在采集中
@@ -27,7 +85,14 @@ extern uint16_t cfg_freq;
 extern uint8_t cfg_odr;
 
 uint8_t KX134_Init(void);
-void KX134_Read_FIFO_DMA(uint8_t *target_buffer);
+uint16_t KX134_FIFO_Samples(void);  // 读 BUF_STATUS，返回缓冲区中完整采样数 (== KX134_FIFO_Capacity() 表示已溢出)
+uint16_t KX134_FIFO_Capacity(void); // 当前分辨率下缓冲区容量 (采样)
+uint8_t KX134_Reconfigure(uint16_t freq_hz, uint8_t res8, const KX134_Adp_t *adp);   // res8: 1 = 8 位缓冲 (BRES=0)；在 DataTask 中调用，FIFO 被清空
+void KX134_Read_FIFO_DMA(int16_t *pX, uint32_t planeStride, uint16_t samples);   // samples <= KX134_FIFO_Capacity()，Y/Z 写到 pX + stride / + 2*stride
+void KX134_FIFO_IrqStamp(void);   // 水位中断 (EXTI) 中调用，记录时刻
+void KX134_FIFO_DMA_Cplt(void);   // SPI DMA 完成中断中调用: 拉高 CS，数据按轴拆分到目标平面
+void KX134_FIFO_Abort(void);      // DMA 超时: 终止传输，拉高 CS 并清空 FIFO
+void KX134_FIFO_Clear(void);      // 丢弃 FIFO 中现有采样 (不读出)
 void KX134_CS_High(void); 
 uint8_t KX134_SetODR(uint16_t freq_hz);
 uint8_t KX134_ReadReg(uint8_t Reg);
@@ -143,4 +143,52 @@ HAL_StatusTypeDef Flash_UpdatePoints(uint16_t new_points) {
     uint8_t a; uint16_t f; uint16_t p;
     Flash_ReadConfig(&a, &f, &p);
     return Flash_WriteConfig(a, f, new_points);
+}
+uint8_t Flash_ReadWindow(void) {
+    flash_dev_cfg_t cfg;
+    Flash_ReadWholeConfig(&cfg);
+    return cfg.window;
+}
+HAL_StatusTypeDef Flash_UpdateWindow(uint8_t win) {
+    flash_dev_cfg_t cfg;
+    Flash_ReadWholeConfig(&cfg); // 读旧数据保留其余配置
+    cfg.window = win;
+    return Flash_ProgramWholeConfig(&cfg);
+}
+uint8_t Flash_ReadRes8(void) {
+    flash_dev_cfg_t cfg;
+    Flash_ReadWholeConfig(&cfg);
+    return cfg.res8;
+}
+HAL_StatusTypeDef Flash_UpdateRes8(uint8_t res8) {
+    flash_dev_cfg_t cfg;
+    Flash_ReadWholeConfig(&cfg);
+    cfg.res8 = res8;
+    return Flash_ProgramWholeConfig(&cfg);
+}
+void Flash_ReadAdp(KX134_Adp_t *adp) {
+    flash_dev_cfg_t cfg;
+    Flash_ReadWholeConfig(&cfg);
+    adp->mode = cfg.adp_mode;
+    adp->hpf_hz = cfg.adp_hpf_hz;
+    adp->lpf_hz = cfg.adp_lpf_hz;
+}
+HAL_StatusTypeDef Flash_UpdateAdp(const KX134_Adp_t *adp) {
+    flash_dev_cfg_t cfg;
+    Flash_ReadWholeConfig(&cfg);
+    cfg.adp_mode = adp->mode;
+    cfg.adp_hpf_hz = adp->hpf_hz;
+    cfg.adp_lpf_hz = adp->lpf_hz;
+    return Flash_ProgramWholeConfig(&cfg);
+}
+uint8_t Flash_ReadBaud(void) {
+    flash_dev_cfg_t cfg;
+    Flash_ReadWholeConfig(&cfg);
+    return cfg.baud_idx;
+}
+HAL_StatusTypeDef Flash_UpdateBaud(uint8_t idx) {
+    flash_dev_cfg_t cfg;
+    Flash_ReadWholeConfig(&cfg);
+    cfg.baud_idx = idx;
+    return Flash_ProgramWholeConfig(&cfg);
 }
\ No newline at end of file
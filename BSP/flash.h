@@ -40,7 +40,12 @@ typedef struct __attribute__((packed,aligned(4))) {
     uint32_t ota_flag;     
     uint32_t fw_len;       
     uint32_t fw_crc;       
-    uint8_t  rsv[8];       
+    uint8_t  window;       // 频谱窗函数编号 (WIN_xxx)，旧配置为 0xFF 时用默认窗
+    uint8_t  res8;         // 1 = KX134 8 位缓冲模式，其他 (含旧配置 0xFF) 为 16 位
+    uint8_t  adp_mode;     // KX134_ADP_xxx，旧配置为 0xFF 时关闭
+    uint16_t adp_hpf_hz;
+    uint16_t adp_lpf_hz;
+    uint8_t  baud_idx;     // 串口波特率编号 (BAUD_IDX_xxx)，旧配置为 0xFF 时 9600
 
     uint16_t crc;          
 } flash_dev_cfg_t;
@@ -59,6 +64,14 @@ uint8_t Flash_ReadDeviceAddr(void);
 HAL_StatusTypeDef Flash_WriteDeviceAddr(uint8_t new_addr);
 HAL_StatusTypeDef Flash_UpdateFreq(uint16_t new_freq);
 HAL_StatusTypeDef Flash_UpdatePoints(uint16_t new_points);
+uint8_t Flash_ReadWindow(void);
+HAL_StatusTypeDef Flash_UpdateWindow(uint8_t win);
+uint8_t Flash_ReadRes8(void);
+HAL_StatusTypeDef Flash_UpdateRes8(uint8_t res8);
+void Flash_ReadAdp(KX134_Adp_t *adp);
+HAL_StatusTypeDef Flash_UpdateAdp(const KX134_Adp_t *adp);
+uint8_t Flash_ReadBaud(void);
+HAL_StatusTypeDef Flash_UpdateBaud(uint8_t idx);
 
 #ifdef __cplusplus
 }
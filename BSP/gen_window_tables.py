@@ -0,0 +1,90 @@
+# -*- coding: utf-8 -*-
+"""
+生成 window_tables.c: 余弦和窗的 q15 半窗表 + 幅值/能量修正系数 (const，放在 Flash)。
+
+    python gen_window_tables.py            # 在 BSP 目录下执行，覆盖 window_tables.c
+
+窗为周期 (DFT-even) 形式 w[n] = a0 - a1*cos(2πn/N) + a2*cos(4πn/N) - ...，中心 w[N/2] = 1。
+只存 n = 0..N/2 (w[N-n] = w[n])；L 点 FFT (L 整除 N) 按步长 N/L 取样即为 L 点同型窗，
+所以一张 WIN_TABLE_LEN 点的表覆盖所有 FFT 长度，修正系数与长度无关。
+WIN_TABLE_LEN / 窗编号须与 window.h 保持一致。
+"""
+import math
+import os
+
+WIN_TABLE_LEN = 4096
+Q15_MAX = 32767          # 表值 = round(w * 32767)，w = 1 精确可表示
+
+# (宏名, 变量名, 说明, 系数 a0..am)
+WINDOWS = [
+    ('WIN_HANN',            's_WinHann',     'Hann',                [0.5, 0.5]),
+    ('WIN_HAMMING',         's_WinHamming',  'Hamming',             [0.54, 0.46]),
+    ('WIN_FLATTOP',         's_WinFlatTop',  'Flat-top (MATLAB flattopwin)',
+     [0.21557895, 0.41663158, 0.277263158, 0.083578947, 0.006947368]),
+    ('WIN_BLACKMAN_HARRIS', 's_WinBlackmanHarris', 'Blackman-Harris 4 项 (-92 dB)',
+     [0.35875, 0.48829, 0.14128, 0.01168]),
+]
+WIN_MAX_TERMS = 4
+
+
+def window_half(a):
+    half = []
+    for n in range(WIN_TABLE_LEN // 2 + 1):
+        w = sum(((-1) ** m) * a[m] * math.cos(2.0 * math.pi * m * n / WIN_TABLE_LEN) for m in range(len(a)))
+        half.append(int(round(w * Q15_MAX)))
+    return half
+
+
+def gains(half):
+    # 由量化后的表值计算，保证修正系数与实际乘上的窗一致
+    full = half + half[-2:0:-1]
+    vals = [q / Q15_MAX for q in full]
+    cg = sum(vals) / len(vals)
+    pg = sum(v * v for v in vals) / len(vals)
+    return cg, pg
+
+
+def fmt_f(x):
+    return '%.9gf' % x if '.' in '%.9g' % x or 'e' in '%.9g' % x else '%.1ff' % x
+
+
+def main():
+    out = []
+    out.append('/* 由 gen_window_tables.py 生成，请勿手工修改 */')
+    out.append('#include "window.h"')
+    out.append('')
+    out.append('#if WIN_TABLE_LEN != %d' % WIN_TABLE_LEN)
+    out.append('#error "window_tables.c is out of date, rerun gen_window_tables.py"')
+    out.append('#endif')
+    infos = []
+    for macro, var, desc, a in WINDOWS:
+        half = window_half(a)
+        cg, pg = gains(half)
+        ratio = [((-1) ** m) * a[m] / a[0] for m in range(1, len(a))]
+        ratio += [0.0] * (WIN_MAX_TERMS - len(ratio))
+        infos.append((macro, var, cg, pg, ratio))
+
+        out.append('')
+        out.append('/* %s: %s */' % (desc, ', '.join('a%d=%.9g' % (m, c) for m, c in enumerate(a))))
+        out.append('static const q15_t %s[WIN_TABLE_LEN / 2 + 1] = {' % var)
+        for i in range(0, len(half), 12):
+            out.append('    ' + ', '.join('%6d' % v for v in half[i:i + 12]) + ',')
+        out.append('};')
+
+    out.append('')
+    out.append('const WinInfo_t g_WinInfo[WIN_TYPE_NUM] = {')
+    out.append('    [WIN_RECT] = { NULL, 1.0f, 1.0f, { 0.0f, 0.0f, 0.0f, 0.0f } },')
+    for macro, var, cg, pg, ratio in infos:
+        out.append('    [%s] = { %s, %s, %s, { %s } },' % (
+            macro, var, fmt_f(cg), fmt_f(pg), ', '.join(fmt_f(r) for r in ratio)))
+    out.append('};')
+    out.append('')
+
+    path = os.path.join(os.path.dirname(os.path.abspath(__file__)), 'window_tables.c')
+    with open(path, 'w', encoding='utf-8', newline='\n') as f:
+        f.write('\n'.join(out))
+    print('wrote', path)
+
+
+if __name__ == '__main__':
+    main()
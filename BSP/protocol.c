@@ -1,10 +1,12 @@
 #include "protocol.h"
+#include "task.h"
 #include "bytes.h"
 #include "string.h"
 #include "stdio.h"
 
 #define PROTOCOL_UART huart1
 #define RX_MIN_LEN     7          
+#define TX_ALLOC_WAIT  pdMS_TO_TICKS(UART_TX_ALLOC_WAIT_MS)
 
 #define MAX_SAMPLE_FREQ_HZ   25600 
 #define MIN_SAMPLE_FREQ_HZ   200   
@@ -15,7 +17,6 @@ extern uint16_t g_cfg_points;
 extern uint8_t LOCAL_DEVICE_ADDR;
 
 extern TaskHandle_t DataTaskHandle; 
-volatile uint8_t g_tx_busy;
 static uint32_t s_received_bytes = 0;
 
 uint8_t uid_me[12];
@@ -60,18 +61,10 @@ uint16_t Modbus_CRC16(const uint8_t *data, uint16_t length)
     return crc;                     
 }
 
-static HAL_StatusTypeDef uart_send_dma(uint8_t *buf, uint16_t len)
+// 按当前波特率发完整个发送池所需时间 + 20ms，用于等待发送完成
+static TickType_t tx_drain_ticks(void)
 {
-		uint32_t timeout_cnt = 0;
-    
-    while (g_tx_busy) {
-        vTaskDelay(1); 
-        timeout_cnt++;
-        if (timeout_cnt > 50) return HAL_BUSY; 
-    }    
-		
-    g_tx_busy = 1; 
-    return HAL_UART_Transmit_DMA(&PROTOCOL_UART, buf, len);
+    return pdMS_TO_TICKS((uint32_t)UART_TX_POOL_N * UART_TX_BUF_SIZE * 10U * 1000U / PROTOCOL_UART.Init.BaudRate + 20U);
 }
 
 /**********************************特征值应答**********************************/
@@ -80,13 +73,14 @@ static void send_feature_pkt(uint8_t dev_id,
                               const AxisFeatureValue *Y_data,
                               const AxisFeatureValue *Z_data)
 {
-    static uint8_t tx[77];  // 3 + 16 + 16 +36 + 4 + 2 = 77 (三个结构体数据) + CRC
+    // 3 + 16 + 16 +36 + 4 + 8 + 24 + 2 = 109 (三个结构体数据) + 温度 + 频域积分 + 包络谱 + CRC
+    uint8_t *tx = UartTx_Alloc(TX_ALLOC_WAIT);
+    if (tx == NULL) return;
     uint8_t *p = tx;
-		memset(tx, 0, sizeof(tx));
 
     *p++ = dev_id;
     *p++ = CMD_FEATURE;
-    *p++ = 0x48;
+    *p++ = 0x68;
 
     // ----- X_data 区域：4 × float (16B) -----
 		put_be_f32(&p, X_data->mean);
@@ -112,6 +106,14 @@ static void send_feature_pkt(uint8_t dev_id,
     put_be_f32(&p, Z_data->envelope_peak);
 		 // -----  temp 区域 -----
     put_be_f32(&p, 0.0f);
+    // ----- Z 频域积分区域：2 × float (8B) -----
+    put_be_f32(&p, Z_data->vel_rms_iso);
+    put_be_f32(&p, Z_data->disp_pp);
+    // ----- Z 包络谱区域：ENV_PEAK_NUM × (频率, 幅值) (24B) -----
+    for (uint32_t n = 0; n < ENV_PEAK_NUM; n++) {
+        put_be_f32(&p, Z_data->env_peak_freq[n]);
+        put_be_f32(&p, Z_data->env_peak_amp[n]);
+    }
 		
 		size_t payload_len = (size_t)(p - tx);      // 已写入的真实字节数
     uint16_t crc = Modbus_CRC16(tx, payload_len);  
@@ -119,22 +121,175 @@ static void send_feature_pkt(uint8_t dev_id,
     *p++ = (crc >> 8) & 0xFF; 
 
 //		HAL_UART_Transmit_DMA(&huart3, tx, (uint16_t)(p - tx));
-		uart_send_dma(tx, (uint16_t)(p - tx));	
+		UartTx_Submit(tx, (uint16_t)(p - tx));	
+}
+
+/**********************************X/Y 主峰应答**********************************/
+/* 帧：dev_id | CMD_XY_PEAKS | LEN | X[peakFreq peakAmp amp2x] | Y[peakFreq peakAmp amp2x] | CRC(LE) */
+static void send_xy_peaks_pkt(uint8_t dev_id)
+{
+    const AxisFeatureValue *axis[2] = { &X_data, &Y_data };
+    uint8_t *tx = UartTx_Alloc(TX_ALLOC_WAIT);
+    if (tx == NULL) return;
+    uint8_t *p = tx;
+
+    *p++ = dev_id;
+    *p++ = CMD_XY_PEAKS;
+    *p++ = 24;
+    for (uint32_t k = 0; k < 2; k++) {
+        put_be_f32(&p, axis[k]->peakFreq);
+        put_be_f32(&p, axis[k]->peakAmp);
+        put_be_f32(&p, axis[k]->amp2x);
+    }
+
+    uint16_t crc = Modbus_CRC16(tx, (size_t)(p - tx));
+    *p++ = (uint8_t)(crc & 0xFF);
+    *p++ = (uint8_t)((crc >> 8) & 0xFF);
+
+    UartTx_Submit(tx, (uint16_t)(p - tx));
+}
+
+/**********************************峰值表应答**********************************/
+/* 帧：dev_id | CMD_PEAKS | LEN | count | PEAK_TABLE_N × (freq f32 | amp f32 | tag | ref) | CRC(LE) */
+static void send_peaks_pkt(uint8_t dev_id)
+{
+    enum { DATA_LEN = 1 + PEAK_TABLE_N * 10 };
+    uint8_t *tx = UartTx_Alloc(TX_ALLOC_WAIT);
+    if (tx == NULL) return;
+    SpecPeak_t tbl[PEAK_TABLE_N];
+    uint8_t *p = tx;
+
+    uint8_t count = Algo_Get_PeakTable(tbl);
+
+    *p++ = dev_id;
+    *p++ = CMD_PEAKS;
+    *p++ = DATA_LEN;
+    *p++ = count;
+    for (uint32_t i = 0; i < PEAK_TABLE_N; i++) {
+        put_be_f32(&p, tbl[i].freq);
+        put_be_f32(&p, tbl[i].amp);
+        *p++ = tbl[i].tag;
+        *p++ = tbl[i].ref;
+    }
+
+    uint16_t crc = Modbus_CRC16(tx, (size_t)(p - tx));
+    *p++ = (uint8_t)(crc & 0xFF);
+    *p++ = (uint8_t)((crc >> 8) & 0xFF);
+
+    UartTx_Submit(tx, (uint16_t)(p - tx));
+}
+
+/**********************************Welch 功率谱应答**********************************/
+/* 帧：dev_id | CMD_PSD | LEN | segs(u16) | peakFreq | peakAmp | amp2x | rms | WELCH_BAND_NUM × band(f32) | CRC(LE) */
+static void send_psd_pkt(uint8_t dev_id)
+{
+    enum { DATA_LEN = 2 + (4 + WELCH_BAND_NUM) * 4 };
+    uint8_t *tx = UartTx_Alloc(TX_ALLOC_WAIT);
+    if (tx == NULL) return;
+    WelchResult_t res;
+    uint8_t *p = tx;
+
+    Algo_Get_Welch(&res);
+
+    *p++ = dev_id;
+    *p++ = CMD_PSD;
+    *p++ = DATA_LEN;
+    put_be_u16(&p, res.segs);
+    put_be_f32(&p, res.peakFreq);
+    put_be_f32(&p, res.peakAmp);
+    put_be_f32(&p, res.amp2x);
+    put_be_f32(&p, res.rms);
+    for (uint32_t i = 0; i < WELCH_BAND_NUM; i++) {
+        put_be_f32(&p, res.band[i]);
+    }
+
+    uint16_t crc = Modbus_CRC16(tx, (size_t)(p - tx));
+    *p++ = (uint8_t)(crc & 0xFF);
+    *p++ = (uint8_t)((crc >> 8) & 0xFF);
+
+    UartTx_Submit(tx, (uint16_t)(p - tx));
+}
+
+static void send_acq_info_pkt(uint8_t dev_id)
+{
+    enum { DATA_LEN = 4 * 4 + 2 + 1 + 9 * 4 };
+    uint8_t *tx = UartTx_Alloc(TX_ALLOC_WAIT);
+    if (tx == NULL) return;
+    AcqFrameInfo_t fi;
+    AcqStats_t st;
+    uint8_t *p = tx;
+
+    Acq_GetLastFrame(&fi, &st);
+
+    *p++ = dev_id;
+    *p++ = CMD_ACQ_INFO;
+    *p++ = DATA_LEN;
+    put_be_u32(&p, fi.seq);
+    put_be_u32(&p, fi.firstSample);
+    put_be_u32(&p, fi.tick);
+    put_be_f32(&p, fi.odrMeas);
+    put_be_u16(&p, fi.blocks);
+    *p++ = fi.flags;
+    put_be_u32(&p, st.samples);
+    put_be_u32(&p, st.overruns);
+    put_be_u32(&p, st.timeouts);
+    put_be_u32(&p, st.gaps);
+    put_be_u32(&p, st.lostSamples);
+    put_be_u32(&p, st.badFrames);
+    put_be_u32(&p, st.droppedFrames);
+    put_be_u32(&p, st.reconfigs);
+    put_be_u32(&p, st.reconfUs);
+
+    uint16_t crc = Modbus_CRC16(tx, (size_t)(p - tx));
+    *p++ = (uint8_t)(crc & 0xFF);
+    *p++ = (uint8_t)((crc >> 8) & 0xFF);
+
+    UartTx_Submit(tx, (uint16_t)(p - tx));
+}
+
+static void send_tx_stats_pkt(uint8_t dev_id)
+{
+    enum { DATA_LEN = 6 * 4 + 2 };
+    uint8_t *tx = UartTx_Alloc(TX_ALLOC_WAIT);
+    if (tx == NULL) return;
+    UartTxStats_t st;
+    uint8_t *p = tx;
+
+    UartTx_GetStats(&st);
+
+    *p++ = dev_id;
+    *p++ = CMD_TX_STATS;
+    *p++ = DATA_LEN;
+    put_be_u32(&p, st.submitted);
+    put_be_u32(&p, st.sent);
+    put_be_u32(&p, st.bytes);
+    put_be_u32(&p, st.allocWaits);
+    put_be_u32(&p, st.allocFails);
+    put_be_u32(&p, st.dmaErrors);
+    *p++ = st.freeMin;
+    *p++ = st.queuedMax;
+
+    uint16_t crc = Modbus_CRC16(tx, (size_t)(p - tx));
+    *p++ = (uint8_t)(crc & 0xFF);
+    *p++ = (uint8_t)((crc >> 8) & 0xFF);
+
+    UartTx_Submit(tx, (uint16_t)(p - tx));
 }
 
 /* 测试用：发送特征包，数据区用 00,11,22,...,FF 循环填充 */
 static void send_feature_pkt_test(uint8_t dev_id)
 {
-    enum { HEADER_LEN = 3, DATA_LEN = 72, CRC_LEN = 2, FRAME_LEN = HEADER_LEN + DATA_LEN + CRC_LEN };
-    static uint8_t tx[FRAME_LEN];
+    enum { HEADER_LEN = 3, DATA_LEN = 104, CRC_LEN = 2, FRAME_LEN = HEADER_LEN + DATA_LEN + CRC_LEN };
+    uint8_t *tx = UartTx_Alloc(TX_ALLOC_WAIT);
+    if (tx == NULL) return;
     uint8_t *p = tx;
 
-    // 头部：dev_id, CMD_FEATURE, 固定 0x48
+    // 头部：dev_id, CMD_FEATURE, 固定 0x68
     *p++ = dev_id;
     *p++ = CMD_FEATURE;
-    *p++ = 0x48;
+    *p++ = 0x68;
 
-    // 数据区：72 字节固定模式填充（00,11,22,...,FF 循环）
+    // 数据区：104 字节固定模式填充（00,11,22,...,FF 循环）
     for (uint32_t i = 0; i < DATA_LEN; ++i) {
         *p++ = (uint8_t)((i & 0x0Fu) * 0x11u);
         // 若你只想在 0x00,0x11,0x22,0x33 四值间循环，可改为：
@@ -145,14 +300,15 @@ static void send_feature_pkt_test(uint8_t dev_id)
     *p++ = (uint8_t)(crc & 0xFF);
     *p++ = (uint8_t)((crc >> 8) & 0xFF);
 
-    // 发送实际帧长（应为 77 字节）
+    // 发送实际帧长（应为 109 字节）
 //		HAL_UART_Transmit_DMA(&huart3, tx, (uint16_t)(p - tx));
-		uart_send_dma(tx, (uint16_t)(p - tx));	
+		UartTx_Submit(tx, (uint16_t)(p - tx));	
 }
 /**********************************波形应答**********************************/
 static void send_wave_ack(uint8_t dev_id)
 {
-    static uint8_t tx[7]; 
+    uint8_t *tx = UartTx_Alloc(TX_ALLOC_WAIT);
+    if (tx == NULL) return;
     uint8_t *p = tx;
 
     *p++ = dev_id;
@@ -167,7 +323,7 @@ static void send_wave_ack(uint8_t dev_id)
     *p++ = (uint8_t)((crc >> 8) & 0xFF); // High
 
 //		HAL_UART_Transmit_DMA(&huart3, tx, (uint16_t)(p - tx));
-		uart_send_dma(tx, (uint16_t)(p - tx));	
+		UartTx_Submit(tx, (uint16_t)(p - tx));	
 }
 
 /* ---- 协议常量 ---- */
@@ -178,35 +334,324 @@ enum { FRAME_NOCRC   = HEADER_NOCRC + DATA_LEN };// 4 + 256 = 260
 enum { CRC_LEN       = 2  };
 enum { FRAME_LEN     = FRAME_NOCRC + CRC_LEN };  // 260 + 2 = 262
 
-/* 帧：dev_id | CMD_WAVE  | seq(1B) |total_pkts(1B) | 64×float(BE) | CRC(LE) */
-static void send_wave_pkt(uint8_t dev_id,const float *buf, uint8_t seq, uint8_t total_pkts)
+/* 帧：dev_id | cmd  | seq(1B) |total_pkts(1B) | 64×float(BE) | CRC(LE)，pts 指向本包第一个点
+ * seq16 = 1 时 seq/total_pkts 各 2 字节 (BE)，用于超过 255 包的长记录。返回帧长 */
+static uint16_t build_f32_pkt(uint8_t *tx, uint8_t dev_id, uint8_t cmd, const float *pts, uint16_t seq, uint16_t total_pkts, uint8_t seq16)
 {
-    if (!buf) return;
-
-    static uint8_t tx[FRAME_LEN]; // FRAME_LEN = 262
-
 		uint8_t *p = tx;
-		uint32_t offset = (uint32_t)seq * PTS_PER_PKT; 
 	
-		/* 头部 4B */
+		/* 头部 4B / 6B */
 		*p++ = dev_id;        // 1B
-		*p++ = CMD_WAVE_PACK;      // 1B
-		*p++ = seq;           // 1B，当前序号
-		*p++ = total_pkts;    // 1B，总包数
+		*p++ = cmd;           // 1B
+		if (seq16) {
+				put_be_u16(&p, seq);
+				put_be_u16(&p, total_pkts);
+		} else {
+				*p++ = (uint8_t)seq;           // 1B，当前序号
+				*p++ = (uint8_t)total_pkts;    // 1B，总包数
+		}
 
 
-    /* 数据区：64 个 float，按大端写入；末包不足补 0.0f */
+    /* 数据区：64 个 float，按大端写入 */
 		for (uint16_t i = 0; i < PTS_PER_PKT; ++i) {
-        float v = buf[offset + i]; 
-        put_be_f32(&p, v);
+        put_be_f32(&p, pts[i]);
     }
 
 		uint16_t crc = Modbus_CRC16(tx, (size_t)(p - tx));
 		*p++ = (uint8_t)(crc & 0xFF);        // Low
 		*p++ = (uint8_t)((crc >> 8) & 0xFF); // High
+		return (uint16_t)(p - tx);
+}
 
-//		HAL_UART_Transmit_DMA(&huart3, tx, (uint16_t)(p - tx));
-		uart_send_dma(tx, (uint16_t)(p - tx));	
+static void send_f32_pkt(uint8_t dev_id, uint8_t cmd, const float *pts, uint16_t seq, uint16_t total_pkts, uint8_t seq16)
+{
+    uint8_t *tx = UartTx_Alloc(TX_ALLOC_WAIT);
+    if (tx == NULL) return;
+
+		UartTx_Submit(tx, build_f32_pkt(tx, dev_id, cmd, pts, seq, total_pkts, seq16));
+}
+
+/**********************************波形编码**********************************/
+/* 快照保存原始 int16 采样，按请求的编码拼包 (见 protocol.h WAVE_ENC_xxx)，每包自带 scale/offset 可单独解码。
+ * DELTA: 各点先右移 shift 位 (8 位分辨率下低 8 位全为 0)，首点原样，其后 63 个差分 d 取 u = zigzag(d)，
+ * q = u >> k；q < WAVE_RICE_ESC 时写 q 个 1、一个 0、k 位余数，否则写 WAVE_RICE_ESC 个 1 后跟 17 位 u。
+ * 位流高位在前，k 逐包取使总位数最小者。 */
+enum { WAVE_TOTAL_PKTS = FFT_POINTS / PTS_PER_PKT };
+enum { WAVE_RICE_ESC = 16, WAVE_RICE_RAW_BITS = 17, WAVE_RICE_K_MAX = 16 };
+enum { WAVE_I16_BYTES = PTS_PER_PKT * 2 };
+
+typedef struct {
+    uint8_t *p;
+    uint32_t acc;
+    uint8_t  n;          // acc 中未输出的位数 (< 8)
+} BitWr_t;
+
+// 写 v 的低 bits 位 (bits <= 24)
+static void bw_put(BitWr_t *w, uint32_t v, uint8_t bits)
+{
+    w->acc = (w->acc << bits) | (v & ((1UL << bits) - 1UL));
+    w->n += bits;
+    while (w->n >= 8) {
+        w->n -= 8;
+        *w->p++ = (uint8_t)(w->acc >> w->n);
+    }
+}
+
+// 第 i 个差分 (i >= 1) 的 zigzag 值，最大 2^17 - 1
+static inline uint32_t wave_zz(const int16_t *x, uint16_t i, uint8_t shift)
+{
+    int32_t d = (int32_t)(x[i] >> shift) - (int32_t)(x[i - 1] >> shift);
+    return (d >= 0) ? ((uint32_t)d << 1) : (((uint32_t)(-d) << 1) - 1U);
+}
+
+/* 输出 k shift x0(i16 BE) 位流，返回字节数；不比 int16 原样更短时返回 0 (该包改用 I16) */
+static uint16_t wave_delta_encode(uint8_t *out, const int16_t *x)
+{
+    uint16_t orv = 0;
+    for (uint16_t i = 0; i < PTS_PER_PKT; i++) orv |= (uint16_t)x[i];
+    uint8_t shift = 0;
+    while (orv != 0 && !(orv & 1U) && shift < 15) { orv >>= 1; shift++; }
+
+    uint32_t bestBits = 0xFFFFFFFFUL;
+    uint8_t  bestK = 0;
+    for (uint8_t k = 0; k <= WAVE_RICE_K_MAX; k++) {
+        uint32_t bits = 0;
+        for (uint16_t i = 1; i < PTS_PER_PKT; i++) {
+            uint32_t q = wave_zz(x, i, shift) >> k;
+            bits += (q < WAVE_RICE_ESC) ? (q + 1U + k) : (WAVE_RICE_ESC + WAVE_RICE_RAW_BITS);
+        }
+        if (bits < bestBits) { bestBits = bits; bestK = k; }
+    }
+    uint16_t total = (uint16_t)(2U + 2U + (bestBits + 7U) / 8U);
+    if (total >= WAVE_I16_BYTES) return 0;
+
+    uint8_t *p = out;
+    *p++ = bestK;
+    *p++ = shift;
+    put_be_u16(&p, (uint16_t)(int16_t)(x[0] >> shift));
+    BitWr_t w = { p, 0, 0 };
+    for (uint16_t i = 1; i < PTS_PER_PKT; i++) {
+        uint32_t u = wave_zz(x, i, shift);
+        uint32_t q = u >> bestK;
+        if (q < WAVE_RICE_ESC) {
+            bw_put(&w, (1UL << (q + 1U)) - 2UL, (uint8_t)(q + 1U));   // q 个 1 + 0
+            if (bestK) bw_put(&w, u, bestK);
+        } else {
+            bw_put(&w, (1UL << WAVE_RICE_ESC) - 1UL, WAVE_RICE_ESC);
+            bw_put(&w, u, WAVE_RICE_RAW_BITS);
+        }
+    }
+    if (w.n) *w.p++ = (uint8_t)(w.acc << (8U - w.n));
+    return (uint16_t)(w.p - out);
+}
+
+/* F32: 同 build_f32_pkt；I16 / DELTA:
+ * dev_id | cmd | seq | total_pkts | enc | plen | scale offset (f32 BE) | 数据 | CRC(LE)
+ * plen 为 enc/plen 之后到 CRC 之前的字节数；加速度 g = (x - offset) * scale
+ * I16 数据: 64 × int16 BE；DELTA 数据: k shift x0(i16 BE) Rice 位流，x = 解码值 << shift */
+static uint16_t build_wave_pkt(uint8_t *tx, uint8_t dev_id, uint8_t cmd, uint8_t seq, uint8_t enc)
+{
+    float mean;
+    const int16_t *x = Algo_Get_Snapshot_Ptr(&mean) + (uint32_t)seq * PTS_PER_PKT;
+
+    if (enc != WAVE_ENC_I16 && enc != WAVE_ENC_DELTA) {
+        float pts[PTS_PER_PKT];
+        for (uint16_t i = 0; i < PTS_PER_PKT; i++) pts[i] = ((float)x[i] - mean) * KX134_SENSITIVITY;
+        return build_f32_pkt(tx, dev_id, cmd, pts, seq, WAVE_TOTAL_PKTS, 0);
+    }
+
+    uint8_t *p = tx;
+    *p++ = dev_id;
+    *p++ = cmd;
+    *p++ = seq;
+    *p++ = WAVE_TOTAL_PKTS;
+    uint8_t *hdr = p;
+    p += 2;
+    put_be_f32(&p, KX134_SENSITIVITY);
+    put_be_f32(&p, mean);
+    if (enc == WAVE_ENC_DELTA) {
+        uint16_t n = wave_delta_encode(p, x);
+        if (n) p += n;
+        else enc = WAVE_ENC_I16;
+    }
+    if (enc == WAVE_ENC_I16) {
+        for (uint16_t i = 0; i < PTS_PER_PKT; i++) put_be_u16(&p, (uint16_t)x[i]);
+    }
+    hdr[0] = enc;
+    hdr[1] = (uint8_t)(p - hdr - 2);
+
+    uint16_t crc = Modbus_CRC16(tx, (uint16_t)(p - tx));
+    *p++ = (uint8_t)crc;
+    *p++ = (uint8_t)(crc >> 8);
+    return (uint16_t)(p - tx);
+}
+
+static void send_wave_pkt(uint8_t dev_id, uint8_t seq, uint8_t enc)
+{
+    if (seq >= WAVE_TOTAL_PKTS) return;
+    uint8_t *tx = UartTx_Alloc(TX_ALLOC_WAIT);
+    if (tx == NULL) return;
+    UartTx_Submit(tx, build_wave_pkt(tx, dev_id, CMD_WAVE_PACK, seq, enc));
+}
+
+/**********************************波形流式下载**********************************/
+/* 一次请求连续推送快照的全部包 (或位图中缺失的包)，帧格式同 CMD_WAVE_PACK。
+ * 推送由 Protocol_Poll 分批进行: 每次只填满发送池的空闲缓冲 (不等待)，发送完成中断直接启动队列中的下一包，
+ * 池满即返回 CommTask 接收命令，1 tick 后接着推；推送期间其他命令 (如波特率确认帧) 照常处理。
+ * CMD_WAVE 重新快照或切换波特率时中止，余下的包由上位机按位图补发。 */
+typedef struct {
+    uint8_t    active;
+    uint8_t    dev_id;
+    uint8_t    enc;
+    uint8_t    seq;                                  // 下一个待查的包序号
+    uint8_t    bitmap[WAVE_STREAM_BITMAP_LEN];       // bit (seq % 8) of byte (seq / 8) 为 1 表示需要发送
+    TickType_t last;                                 // 最近一次成功申请到缓冲的时刻
+} WaveStream_t;
+
+static WaveStream_t s_Stream;
+
+static void Wave_StreamStop(void)
+{
+    s_Stream.active = 0;
+}
+
+// bitmap: NULL = 全部
+static void send_wave_stream(uint8_t dev_id, const uint8_t *bitmap, uint8_t enc)
+{
+    if (bitmap) memcpy(s_Stream.bitmap, bitmap, WAVE_STREAM_BITMAP_LEN);
+    else memset(s_Stream.bitmap, 0xFF, WAVE_STREAM_BITMAP_LEN);
+    s_Stream.dev_id = dev_id;
+    s_Stream.enc = enc;
+    s_Stream.seq = 0;
+    s_Stream.last = xTaskGetTickCount();
+    s_Stream.active = 1;
+}
+
+// 不阻塞地推送到发送池满，返回 1 = 还有包未发
+static uint8_t Wave_StreamPump(void)
+{
+    // 停滞超时 = 按当前波特率的单包发送时间 + 20ms
+    TickType_t timeout = pdMS_TO_TICKS((uint32_t)FRAME_LEN * 10U * 1000U / PROTOCOL_UART.Init.BaudRate + 20U);
+    while (s_Stream.active) {
+        if (s_Stream.seq >= WAVE_TOTAL_PKTS) { s_Stream.active = 0; break; }
+        uint8_t seq = s_Stream.seq;
+        if (!(s_Stream.bitmap[seq >> 3] & (1U << (seq & 7)))) { s_Stream.seq++; continue; }
+        uint8_t *tx = UartTx_Alloc(0);
+        if (tx == NULL) {
+            // 发送停滞，余下的包由上位机按位图补发
+            if (xTaskGetTickCount() - s_Stream.last > timeout) s_Stream.active = 0;
+            break;
+        }
+        UartTx_Submit(tx, build_wave_pkt(tx, s_Stream.dev_id, CMD_WAVE_STREAM, seq, s_Stream.enc));
+        s_Stream.seq++;
+        s_Stream.last = xTaskGetTickCount();
+    }
+    return s_Stream.active;
+}
+
+/**********************************触发捕获应答**********************************/
+/* 帧：dev_id | CMD_TRIG_INFO | LEN | state mode axis flags | pre len threshold odr (u16) | trigSample trigTick (u32) | CRC(LE) */
+static void send_trig_info_pkt(uint8_t dev_id)
+{
+    enum { TRIG_INFO_LEN = 4 + 4 * 2 + 2 * 4 };
+    uint8_t *tx = UartTx_Alloc(TX_ALLOC_WAIT);
+    if (tx == NULL) return;
+    TrigInfo_t ti;
+    uint8_t *p = tx;
+
+    Trig_GetInfo(&ti);
+
+    *p++ = dev_id;
+    *p++ = CMD_TRIG_INFO;
+    *p++ = TRIG_INFO_LEN;
+    *p++ = ti.state;
+    *p++ = ti.mode;
+    *p++ = ti.axis;
+    *p++ = ti.flags;
+    put_be_u16(&p, ti.pre);
+    put_be_u16(&p, ti.len);
+    put_be_u16(&p, ti.threshold);
+    put_be_u16(&p, ti.odr);
+    put_be_u32(&p, ti.trigSample);
+    put_be_u32(&p, ti.trigTick);
+
+    uint16_t crc = Modbus_CRC16(tx, (size_t)(p - tx));
+    *p++ = (uint8_t)(crc & 0xFF);
+    *p++ = (uint8_t)((crc >> 8) & 0xFF);
+
+    UartTx_Submit(tx, (uint16_t)(p - tx));
+}
+
+/* 捕获按时间顺序每包 64 点 (g)，未冻结或 seq 越界时不应答 */
+static void send_trig_pkt(uint8_t dev_id, uint8_t seq)
+{
+    int16_t raw[PTS_PER_PKT];
+    float pts[PTS_PER_PKT];
+
+    if (Trig_Read(raw, (uint16_t)seq * PTS_PER_PKT, PTS_PER_PKT) != PTS_PER_PKT) return;
+    for (uint16_t i = 0; i < PTS_PER_PKT; ++i) {
+        pts[i] = (float)raw[i] * KX134_SENSITIVITY;
+    }
+    send_f32_pkt(dev_id, CMD_TRIG_PACK, pts, seq, TRIG_CAPTURE_LEN / PTS_PER_PKT, 0);
+}
+
+/**********************************长记录应答**********************************/
+/* 帧：dev_id | CMD_LREC | LEN | state axis decim pack8 flags | odr(u16) | target count firstSample tickStart tickEnd (u32) | CRC(LE) */
+static void send_lrec_info_pkt(uint8_t dev_id)
+{
+    enum { LREC_INFO_LEN = 5 + 2 + 5 * 4 };
+    uint8_t *tx = UartTx_Alloc(TX_ALLOC_WAIT);
+    if (tx == NULL) return;
+    LRecInfo_t li;
+    uint8_t *p = tx;
+
+    LRec_GetInfo(&li);
+
+    *p++ = dev_id;
+    *p++ = CMD_LREC;
+    *p++ = LREC_INFO_LEN;
+    *p++ = li.state;
+    *p++ = li.axis;
+    *p++ = li.decim;
+    *p++ = li.pack8;
+    *p++ = li.flags;
+    put_be_u16(&p, li.odr);
+    put_be_u32(&p, li.target);
+    put_be_u32(&p, li.count);
+    put_be_u32(&p, li.firstSample);
+    put_be_u32(&p, li.tickStart);
+    put_be_u32(&p, li.tickEnd);
+
+    uint16_t crc = Modbus_CRC16(tx, (size_t)(p - tx));
+    *p++ = (uint8_t)(crc & 0xFF);
+    *p++ = (uint8_t)((crc >> 8) & 0xFF);
+
+    UartTx_Submit(tx, (uint16_t)(p - tx));
+}
+
+/* rx[2] 子命令: LREC_START 时 rx[3] axis rx[4] decim rx[5] pack8 rx[6..9] 点数 (u32 BE，0 = 记满) */
+static void Handle_LRec(uint8_t dev_id, const uint8_t *rx, uint16_t len)
+{
+    if (rx[2] == LREC_START && len >= 10 + 2) {
+        LRec_Start(rx[3], rx[4], rx[5], rd_be32(&rx[6]));
+    } else if (rx[2] == LREC_RELEASE) {
+        LRec_Release();
+    }
+    send_lrec_info_pkt(dev_id);
+}
+
+/* 记录完成后按 64 点一包读取，末包不足补 0；未完成或 seq 越界时不应答 */
+static void send_lrec_pkt(uint8_t dev_id, const uint8_t *rx)
+{
+    float pts[PTS_PER_PKT];
+    LRecInfo_t li;
+    uint16_t seq = rd_be16(&rx[2]);
+
+    LRec_GetInfo(&li);
+    uint16_t n = LRec_Read(pts, (uint32_t)seq * PTS_PER_PKT, PTS_PER_PKT);
+    if (n == 0) return;
+    for (uint16_t i = n; i < PTS_PER_PKT; ++i) pts[i] = 0.0f;
+    send_f32_pkt(dev_id, CMD_LREC_PACK, pts, seq, (uint16_t)((li.count + PTS_PER_PKT - 1) / PTS_PER_PKT), 1);
 }
 
 /*static void dump_uid(const char* tag, const uint8_t* p) {
@@ -218,28 +663,10 @@ static void send_wave_pkt(uint8_t dev_id,const float *buf, uint8_t seq, uint8_t
 /**********************************广播发现应答**********************************/
 static void send_discover_rsp(uint8_t cur_addr)
 {
-    static uint8_t tx[25]; // 稍微开大一点
-    uint8_t *p = tx;
-
     uint8_t uid[12];
     UID_Fill_BE_w0w1w2(uid); // 获取唯一ID
 
-    /* --- 1. 构造报文 --- */
-    *p++ = cur_addr;       // 地址
-    *p++ = CMD_DISCOVER;   // 功能码
-    *p++ = 13;             // 长度
-    memcpy(p, uid, 12);    // UID
-    p += 12;
-    *p++ = cur_addr;       // 地址后缀
-
-    /* --- 2. 计算CRC --- */
-    uint16_t crc = Modbus_CRC16(tx, (uint16_t)(p - tx));
-    *p++ = (uint8_t)(crc & 0xFF);
-    *p++ = (uint8_t)(crc >> 8);
-    
-    uint16_t packet_len = (uint16_t)(p - tx);
-
-    /* --- 3. 冲突退避逻辑 (核心修改) --- */
+    /* --- 1. 冲突退避逻辑 (核心修改) --- */
     
     // A. 基础时间片 (Slot Time)
     // 9600波特率发一包(约20字节)耗时约21ms。
@@ -266,13 +693,32 @@ static void send_discover_rsp(uint8_t cur_addr)
     // 最大延时 = 99 * 30ms = 2970ms (约3秒)
     uint32_t total_delay = random_slot * slot_time_ms;
     
-    // D. 执行延时
-    HAL_Delay(total_delay);
+    // D. 执行延时 (让出 CPU；发送缓冲延时结束后再取，等待期间不占用)
+    vTaskDelay(pdMS_TO_TICKS(total_delay));
+
+    /* --- 2. 构造报文 --- */
+    uint8_t *tx = UartTx_Alloc(TX_ALLOC_WAIT);
+    if (tx == NULL) return;
+    uint8_t *p = tx;
+
+    *p++ = cur_addr;       // 地址
+    *p++ = CMD_DISCOVER;   // 功能码
+    *p++ = 13;             // 长度
+    memcpy(p, uid, 12);    // UID
+    p += 12;
+    *p++ = cur_addr;       // 地址后缀
+
+    /* --- 3. 计算CRC --- */
+    uint16_t crc = Modbus_CRC16(tx, (uint16_t)(p - tx));
+    *p++ = (uint8_t)(crc & 0xFF);
+    *p++ = (uint8_t)(crc >> 8);
+    
+    uint16_t packet_len = (uint16_t)(p - tx);
 
     /* --- 4. 发送数据 --- */
     // 发送前再检查一下总线是否空闲会更稳健，但在HAL库里比较麻烦，
     // 只要时间槽错开，直接发通常没问题。
-    uart_send_dma(tx, packet_len); 
+    UartTx_Submit(tx, packet_len); 
 }
 
 /**********************************配置地址应答**********************************/
@@ -300,25 +746,27 @@ static bool HandleSetAddr_Broadcast(const uint8_t* rx, uint16_t flen)
 
     // 幂等：一样就只回 ACK
     if (LOCAL_DEVICE_ADDR == new_addr) {
-        static uint8_t tx[5+2];
+        uint8_t *tx = UartTx_Alloc(TX_ALLOC_WAIT);
+        if (tx == NULL) return true;
 				uint8_t *p = tx;
         *p++ = new_addr; *p++ = CMD_SET_ADDR; *p++ = 0x02; *p++ = 0x4F;*p++ = 0x4B;
         uint16_t crc = Modbus_CRC16(tx, (uint16_t)(p - tx));
         *p++ = (uint8_t)crc; *p++ = (uint8_t)(crc >> 8);
 		//		HAL_UART_Transmit_DMA(&huart3, tx, (uint16_t)(p - tx));
-				uart_send_dma(tx, (uint16_t)(p - tx));	
+				UartTx_Submit(tx, (uint16_t)(p - tx));	
         return true;
     }
 
     if (Flash_WriteDeviceAddr(new_addr) == HAL_OK) {
         LOCAL_DEVICE_ADDR = new_addr;
-        static uint8_t tx[5+2];
+        uint8_t *tx = UartTx_Alloc(TX_ALLOC_WAIT);
+        if (tx == NULL) return true;
 				uint8_t *p = tx;
         *p++ = new_addr; *p++ = CMD_SET_ADDR; *p++ = 0x02; *p++ = 0x4F;*p++ = 0x4B;
         uint16_t crc = Modbus_CRC16(tx, (uint16_t)(p - tx));
         *p++ = (uint8_t)crc; *p++ = (uint8_t)(crc >> 8);
 		//		HAL_UART_Transmit_DMA(&huart3, tx, (uint16_t)(p - tx));
-				uart_send_dma(tx, (uint16_t)(p - tx));	
+				UartTx_Submit(tx, (uint16_t)(p - tx));	
     }
     return true;
 }
@@ -335,20 +783,63 @@ static void Config_ParseAndApply_Freq(const uint8_t* rx)
     }
     if (Flash_UpdateFreq(f) == HAL_OK) 
 		{
-				vTaskSuspend(DataTaskHandle);
-        g_cfg_freq_hz = f;
-        KX134_SetODR(g_cfg_freq_hz);
-        //uint8_t reg_val = KX134_ReadReg(KX134_ODCNTL); // 读 0x21 寄存器
-        g_ResetAcqReq = 1;
-				vTaskResume(DataTaskHandle);
+        Acq_RequestReconfig(f, ACQ_RECONF_KEEP, NULL);   // DataTask 在块边界切换，g_cfg_freq_hz 随之更新
     }
 		//taskEXIT_CRITICAL();
 }
 
+/**********************************解析窗函数配置**********************************/
+static void Config_ParseAndApply_Window(const uint8_t* rx)
+{
+		uint8_t win = rx[3];                 // dev|cmd|sub 之后 1 字节，WIN_xxx
+		if (win >= WIN_TYPE_NUM) return;
+		if (Flash_UpdateWindow(win) == HAL_OK)
+		{
+				g_cfg_window = win;              // AlgoTask 下一帧开始时生效，无需重启采集
+		}
+}
+
+/**********************************解析分辨率配置**********************************/
+static void Config_ParseAndApply_Resolution(const uint8_t* rx)
+{
+		uint8_t res8 = rx[3];
+		if (res8 > 1) return;
+		if (Flash_UpdateRes8(res8) == HAL_OK)
+		{
+				Acq_RequestReconfig(0, res8, NULL);    // FIFO 随切换清空，旧格式数据不会混入
+		}
+}
+
+/**********************************解析触发配置**********************************/
+/* rx[3] mode | rx[4] axis | rx[5..6] 阈值 mg (BE) | rx[7..8] 预触发采样数 (BE)，不持久化 */
+static void Config_ParseAndApply_Trigger(const uint8_t* rx, uint16_t len)
+{
+		if (len < 9 + 2) return;
+		Trig_Config(rx[3], rx[4], rd_be16(&rx[5]), rd_be16(&rx[7]));
+}
+
+/**********************************解析 ADP 配置**********************************/
+/* rx[3] mode | rx[4..5] 高通截止 Hz (BE) | rx[6..7] 低通截止 Hz (BE)，0 = 该级旁路 */
+static void Config_ParseAndApply_Adp(const uint8_t* rx, uint16_t len)
+{
+		if (len < 8 + 2) return;
+		KX134_Adp_t adp;
+		adp.mode = rx[3];
+		adp.hpf_hz = rd_be16(&rx[4]);
+		adp.lpf_hz = rd_be16(&rx[6]);
+		if (adp.mode >= KX134_ADP_MODE_NUM) return;
+		if (adp.hpf_hz != 0 && adp.lpf_hz != 0 && adp.hpf_hz >= adp.lpf_hz) return;
+		if (Flash_UpdateAdp(&adp) == HAL_OK)
+		{
+				Acq_RequestReconfig(0, ACQ_RECONF_KEEP, &adp);
+		}
+}
+
 /**********************************采样配置应答**********************************/
 static void Cfg_SendAck(uint8_t dev_id)
 {
-    static uint8_t tx[5 + 2];      
+    uint8_t *tx = UartTx_Alloc(TX_ALLOC_WAIT);
+    if (tx == NULL) return;
     uint8_t *p = tx;
 
     *p++ = dev_id;
@@ -362,12 +853,13 @@ static void Cfg_SendAck(uint8_t dev_id)
     *p++ = (uint8_t)(crc >> 8);
 
 //		HAL_UART_Transmit_DMA(&huart3, tx, (uint16_t)(p - tx));
-		uart_send_dma(tx, (uint16_t)(p - tx));	
+		UartTx_Submit(tx, (uint16_t)(p - tx));	
 }
 /**********************************校准配置应答**********************************/
 static void CALIBRATION_Config_SendAck(uint8_t dev_id)
 {
-		static uint8_t tx[5 + 2];
+		uint8_t *tx = UartTx_Alloc(TX_ALLOC_WAIT);
+		if (tx == NULL) return;
 		uint8_t *p = tx;
 		*p++ = dev_id;
 		*p++ = CMD_CALIBRATION;
@@ -378,7 +870,110 @@ static void CALIBRATION_Config_SendAck(uint8_t dev_id)
     *p++ = (uint8_t)crc;
     *p++ = (uint8_t)(crc >> 8);
 //		HAL_UART_Transmit_DMA(&huart3, tx, (uint16_t)(p - tx));
-		uart_send_dma(tx, (uint16_t)(p - tx));	
+		UartTx_Submit(tx, (uint16_t)(p - tx));	
+}
+
+/**********************************波特率协商**********************************/
+static const uint32_t s_BaudTable[BAUD_IDX_NUM] = { 9600, 19200, 38400, 57600, 115200, 230400, 460800, 921600 };
+static uint8_t  s_BaudIdx = BAUD_IDX_9600;      // 当前使用的波特率
+static uint8_t  s_BaudProbation = 0;            // 1 = 试用中，尚未收到确认帧
+static TickType_t s_BaudStart = 0;              // 进入试用的时刻
+
+// USART1 在 APB2 上，16 倍过采样时 BRR = PCLK2 / baud (1/16 精度)，分频误差过大则不可用
+static bool Baud_Supported(uint8_t idx)
+{
+    if (idx >= BAUD_IDX_NUM) return false;
+    uint32_t pclk = HAL_RCC_GetPCLK2Freq();
+    uint32_t baud = s_BaudTable[idx];
+    uint32_t brr = (pclk + baud / 2) / baud;
+    if (brr < 16) return false;
+    uint32_t real = pclk / brr;
+    uint32_t diff = (real > baud) ? (real - baud) : (baud - real);
+    return (uint64_t)diff * 1000U <= (uint64_t)baud * BAUD_MAX_ERR_PERMILLE;
+}
+
+static void Baud_Switch(uint8_t idx, uint8_t probation)
+{
+    Wave_StreamStop();
+    Uart1_SetBaud(s_BaudTable[idx]);
+    s_BaudIdx = idx;
+    s_BaudProbation = probation;
+    s_BaudStart = xTaskGetTickCount();
+}
+
+void Protocol_BaudBoot(uint8_t idx)
+{
+    if (idx == BAUD_IDX_9600 || !Baud_Supported(idx)) return;
+    Baud_Switch(idx, 1);             // 调度器未启动，tick 为 0
+}
+
+static TickType_t Baud_Poll(void)
+{
+    if (!s_BaudProbation) return portMAX_DELAY;
+    TickType_t elapsed = xTaskGetTickCount() - s_BaudStart;
+    if (elapsed < pdMS_TO_TICKS(BAUD_PROBATION_MS)) return pdMS_TO_TICKS(BAUD_PROBATION_MS) - elapsed;
+
+    // 试用期内没有收到确认帧: 回落到 9600，Flash 不变
+    UartTx_Flush(tx_drain_ticks());
+    Baud_Switch(BAUD_IDX_9600, 0);
+    return portMAX_DELAY;
+}
+
+TickType_t Protocol_Poll(void)
+{
+    TickType_t wait = Baud_Poll();
+    if (Wave_StreamPump()) wait = 1;     // 发送池满，下个 tick 接着推
+    return wait;
+}
+
+// 试用期间收到 CRC 正确的帧: 新波特率可用，确认并持久化
+static void Baud_Confirm(void)
+{
+    s_BaudProbation = 0;
+    uint8_t stored = Flash_ReadBaud();
+    if (stored >= BAUD_IDX_NUM) stored = BAUD_IDX_9600;   // 旧配置为 0xFF
+    if (stored != s_BaudIdx) Flash_UpdateBaud(s_BaudIdx);
+}
+
+/* 帧：dev_id | CMD_BAUD | LEN | idx state result | CRC(LE) */
+static uint32_t send_baud_rsp(uint8_t dev_id, uint8_t idx, uint8_t state, uint8_t result)
+{
+    uint8_t *tx = UartTx_Alloc(TX_ALLOC_WAIT);
+    if (tx == NULL) return 0;
+    uint8_t *p = tx;
+
+    *p++ = dev_id;
+    *p++ = CMD_BAUD;
+    *p++ = 3;
+    *p++ = idx;
+    *p++ = state;
+    *p++ = result;
+
+    uint16_t crc = Modbus_CRC16(tx, (uint16_t)(p - tx));
+    *p++ = (uint8_t)crc;
+    *p++ = (uint8_t)(crc >> 8);
+    return UartTx_Submit(tx, (uint16_t)(p - tx));
+}
+
+static void Handle_Baud(uint8_t dev_id, uint8_t idx)
+{
+    if (idx == BAUD_QUERY || idx == s_BaudIdx) {
+        send_baud_rsp(dev_id, s_BaudIdx, s_BaudProbation, 0);
+        return;
+    }
+    if (!Baud_Supported(idx)) {
+        send_baud_rsp(dev_id, s_BaudIdx, s_BaudProbation, 1);
+        return;
+    }
+
+    // 以旧波特率应答，等最后一个字节移出后再切换；应答没能入队则不切换
+    uint32_t ticket = send_baud_rsp(dev_id, idx, 1, 0);
+    if (ticket == 0) {
+        send_baud_rsp(dev_id, s_BaudIdx, s_BaudProbation, 1);
+        return;
+    }
+    UartTx_Wait(ticket, tx_drain_ticks());
+    Baud_Switch(idx, 1);
 }
 
 /**********************************OTA处理函数**********************************/
@@ -418,17 +1013,19 @@ static void Handle_OTA_Start(uint8_t dev_id, const uint8_t *rx_data)
     if (HAL_FLASHEx_Erase(&EraseInitStruct, &SectorError) == HAL_OK)
     {
         // 擦除成功，回复 ACK
-        static uint8_t tx[7];
-        uint8_t *p = tx;
-        *p++ = dev_id; 
-        *p++ = CMD_OTA_START; 
-        *p++ = 0x02; *p++ = 0x4F; *p++ = 0x4B; // OK
-        
-        uint16_t crc = Modbus_CRC16(tx, (uint16_t)(p - tx));
-        *p++ = (uint8_t)(crc & 0xFF); 
-        *p++ = (uint8_t)(crc >> 8);
-        
-        uart_send_dma(tx, (uint16_t)(p - tx)); // 使用 protocol.c 定义的发送函数
+        uint8_t *tx = UartTx_Alloc(TX_ALLOC_WAIT);
+        if (tx != NULL) {
+            uint8_t *p = tx;
+            *p++ = dev_id; 
+            *p++ = CMD_OTA_START; 
+            *p++ = 0x02; *p++ = 0x4F; *p++ = 0x4B; // OK
+            
+            uint16_t crc = Modbus_CRC16(tx, (uint16_t)(p - tx));
+            *p++ = (uint8_t)(crc & 0xFF); 
+            *p++ = (uint8_t)(crc >> 8);
+            
+            UartTx_Submit(tx, (uint16_t)(p - tx));
+        }
     }
     
     HAL_FLASH_Lock();
@@ -492,7 +1089,8 @@ static void Handle_OTA_Data(uint8_t dev_id, const uint8_t *rx_data, uint16_t fra
         s_received_bytes += expect_len; // 累加接收字节数
 
         // 回复 ACK   
-        static uint8_t tx[7];
+        uint8_t *tx = UartTx_Alloc(TX_ALLOC_WAIT);
+        if (tx == NULL) return;
         uint8_t *p = tx;
         *p++ = dev_id; 
         *p++ = CMD_OTA_DATA; 
@@ -501,7 +1099,7 @@ static void Handle_OTA_Data(uint8_t dev_id, const uint8_t *rx_data, uint16_t fra
         uint16_t crc = Modbus_CRC16(tx, (uint16_t)(p - tx));
         *p++ = (uint8_t)(crc & 0xFF); 
         *p++ = (uint8_t)(crc >> 8);        
-        uart_send_dma(tx, (uint16_t)(p - tx));    
+        UartTx_Submit(tx, (uint16_t)(p - tx));    
     }
 }
 
@@ -518,19 +1116,20 @@ static void Handle_OTA_End(uint8_t dev_id, const uint8_t *rx_data)
     }
 
     // 1. 回复 ACK 
-    static uint8_t tx[7];
-    uint8_t *p = tx;
-    *p++ = dev_id; 
-    *p++ = CMD_OTA_END; // 修正：原代码此处回复的是 CMD_OTA_START (0x50)，改为 END (0x52) 对应
-    *p++ = 0x02; *p++ = 0x4F; *p++ = 0x4B; 
-    
-    uint16_t crc = Modbus_CRC16(tx, (uint16_t)(p - tx));
-    *p++ = (uint8_t)(crc & 0xFF); 
-    *p++ = (uint8_t)(crc >> 8);
-  
-    // 使用阻塞发送，确保重启前数据已发出
-    // 注意：Protocol_UART 宏在 protocol.c 中定义为 huart1
-    HAL_UART_Transmit(&PROTOCOL_UART, tx, 7, 100); 
+    uint8_t *tx = UartTx_Alloc(TX_ALLOC_WAIT);
+    if (tx != NULL) {
+        uint8_t *p = tx;
+        *p++ = dev_id; 
+        *p++ = CMD_OTA_END; // 修正：原代码此处回复的是 CMD_OTA_START (0x50)，改为 END (0x52) 对应
+        *p++ = 0x02; *p++ = 0x4F; *p++ = 0x4B; 
+        
+        uint16_t crc = Modbus_CRC16(tx, (uint16_t)(p - tx));
+        *p++ = (uint8_t)(crc & 0xFF); 
+        *p++ = (uint8_t)(crc >> 8);
+        UartTx_Submit(tx, (uint16_t)(p - tx));
+    }
+    // 等队列发空，确保重启前应答已发出
+    UartTx_Flush(tx_drain_ticks());
 
     // 2. 设置标志位 (调用 flash.c 接口，保留参数区)
     Flash_SetOTAInfo(OTA_FLAG_UPDATE_NEEDED, fw_len);
@@ -551,6 +1150,9 @@ void Protocol_HandleRxFrame(const uint8_t *rx, uint16_t len, uint8_t local_addre
 //        return;
 //    }
 
+    // 试用期间收到帧 (uart_rx 只交出 CRC 正确的帧) 即说明新波特率可用
+    if (s_BaudProbation) Baud_Confirm();
+
     uint8_t dev_id = rx[0];                       // 提取请求中的设备地址
     uint8_t cmd    = rx[1];
 		uint8_t b2   	 = rx[2];
@@ -575,9 +1177,30 @@ void Protocol_HandleRxFrame(const uint8_t *rx, uint16_t len, uint8_t local_addre
     switch (cmd)
     {
     case CMD_FEATURE: send_feature_pkt(dev_id, &X_data, &Y_data, &Z_data); break;
-		case CMD_WAVE:Create_Wave_Snapshot();send_wave_ack(dev_id); break;
-		case CMD_WAVE_PACK:	send_wave_pkt(dev_id, Algo_Get_Snapshot_Ptr(), b2, b3); break;
-		case CMD_CONFIG:Config_ParseAndApply_Freq(rx);Cfg_SendAck(dev_id); break;      
+		case CMD_PEAKS: send_peaks_pkt(dev_id); break;
+		case CMD_PSD: send_psd_pkt(dev_id); break;
+		case CMD_ACQ_INFO: send_acq_info_pkt(dev_id); break;
+		case CMD_TRIG_INFO: send_trig_info_pkt(dev_id); break;
+		case CMD_TRIG_PACK: send_trig_pkt(dev_id, b2); break;
+		case CMD_LREC: Handle_LRec(dev_id, rx, len); break;
+		case CMD_LREC_PACK: send_lrec_pkt(dev_id, rx); break;
+		case CMD_WAVE:Wave_StreamStop();Create_Wave_Snapshot();send_wave_ack(dev_id); break;
+		case CMD_WAVE_PACK:	send_wave_pkt(dev_id, b2, rx[4]); break;
+		case CMD_WAVE_STREAM:
+				if (b2 == WAVE_STREAM_ALL) send_wave_stream(dev_id, NULL, b3);
+				else if (b2 == WAVE_STREAM_BITMAP && len >= 3 + WAVE_STREAM_BITMAP_LEN + 2)
+						send_wave_stream(dev_id, &rx[3], (len >= 3 + WAVE_STREAM_BITMAP_LEN + 1 + 2) ? rx[3 + WAVE_STREAM_BITMAP_LEN] : WAVE_ENC_F32);
+				break;
+		case CMD_BAUD: Handle_Baud(dev_id, b2); break;
+		case CMD_TX_STATS: send_tx_stats_pkt(dev_id); break;
+		case CMD_XY_PEAKS: send_xy_peaks_pkt(dev_id); break;
+		case CMD_CONFIG:
+				if (b2 == WINDOW) Config_ParseAndApply_Window(rx);
+				else if (b2 == RESOLUTION) Config_ParseAndApply_Resolution(rx);
+				else if (b2 == TRIGGER) Config_ParseAndApply_Trigger(rx, len);
+				else if (b2 == ADP) { if (!KX134_ADP_ENABLE) break; Config_ParseAndApply_Adp(rx, len); }   // 未启用时不应答
+				else Config_ParseAndApply_Freq(rx);
+				Cfg_SendAck(dev_id); break;      
     //case CMD_CALIBRATION:Z_Calib_Z_Upright_Neg1G(g_data_z, 100);CALIBRATION_Config_SendAck(dev_id); break;
     /*case CMD_TEST: 
         switch (b2)
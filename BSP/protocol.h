@@ -3,6 +3,7 @@
 #include "main.h"
 #include "usart.h"
 #include "Eigenvalue calculation.h" 
+#include "uart_tx.h"
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -12,6 +13,7 @@
 /*
 XY: mean RMS PP 
 Z:	mean RMS PP Displacement_PP Envelope_Vrms Envelope_Peak
+各命令的请求/应答格式见 docs/protocol.md
 */
 
 /* ────────── Command 定义 ────────── */
@@ -19,6 +21,17 @@ Z:	mean RMS PP Displacement_PP Envelope_Vrms Envelope_Peak
 #define CMD_FEATURE      0x02     /* 特征值请求  */
 #define CMD_WAVE         0x04     /* 波形请求    */
 #define CMD_WAVE_PACK    0x03     /* 波形包请求  */
+#define CMD_PEAKS        0x05     /* 频谱峰值表请求 */
+#define CMD_PSD          0x06     /* Welch 功率谱结果请求 */
+#define CMD_ACQ_INFO     0x07     /* 采集帧完整性/时间戳请求 */
+#define CMD_TRIG_INFO    0x08     /* 触发捕获状态请求 */
+#define CMD_TRIG_PACK    0x09     /* 触发捕获数据包请求 (rx[2] = 包序号) */
+#define CMD_LREC         0x0A     /* 长记录控制/状态 (rx[2] = LREC_xxx) */
+#define CMD_LREC_PACK    0x0B     /* 长记录数据包请求 (rx[2..3] = 包序号 BE) */
+#define CMD_WAVE_STREAM  0x0C     /* 波形快照流式下载 (rx[2] = WAVE_STREAM_xxx) */
+#define CMD_BAUD         0x0D     /* 串口波特率协商 (rx[2] = BAUD_IDX_xxx / BAUD_QUERY) */
+#define CMD_TX_STATS     0x0E     /* 串口发送队列统计请求 */
+#define CMD_XY_PEAKS     0x0F     /* X/Y 轴频谱主峰请求 */
 #define CMD_TEST         0x77     /* 测试请求    */
 #define CMD_DISCOVER     0x41   	 /* 主站广播发现*/
 #define CMD_SET_ADDR  	 0x42   	 /* 主站广播给某uid配置地址*/
@@ -37,14 +50,44 @@ Z:	mean RMS PP Displacement_PP Envelope_Vrms Envelope_Peak
 #define CH_Y3         	 	0x08
 #define CH_Z3        		0x09
 #define FIXED_THIRD_BYTE    0xFF
+/* ────────── LREC 子命令 ────────── */
+#define LREC_QUERY          0x00
+#define LREC_START          0x01
+#define LREC_RELEASE        0x02     /* 终止记录或读取完成，恢复正常采集与分析 */
+/* ────────── WAVE_STREAM 子命令 ────────── */
+#define WAVE_STREAM_ALL     0x00
+#define WAVE_STREAM_BITMAP  0x01     /* 只补发位图中的包 */
+#define WAVE_STREAM_BITMAP_LEN  8    /* 64 包 / 8 */
+/* ────────── 波形编码 ────────── */
+#define WAVE_ENC_F32        0x00     /* 64 × float，262 字节/包 */
+#define WAVE_ENC_I16        0x01     /* 原始 int16 + scale/offset，144 字节/包 */
+#define WAVE_ENC_DELTA      0x02     /* 差分 + zigzag + Rice，无损，典型 60~70 字节/包 */
+/* ────────── 波特率编号 ────────── */
+#define BAUD_IDX_9600       0        /* 默认，出厂及回落波特率 */
+#define BAUD_IDX_19200      1
+#define BAUD_IDX_38400      2
+#define BAUD_IDX_57600      3
+#define BAUD_IDX_115200     4
+#define BAUD_IDX_230400     5
+#define BAUD_IDX_460800     6
+#define BAUD_IDX_921600     7
+#define BAUD_IDX_NUM        8
+#define BAUD_QUERY          0xFF     /* 只查询，不切换 */
+#define BAUD_PROBATION_MS   3000     /* 切换/上电后等待确认帧的时间 */
+#define BAUD_MAX_ERR_PERMILLE  20    /* 分频误差上限 (‰)，超过则拒绝该波特率 */
 /* ────────── CONfIG Command 定义 ────────── */
 #define FREQ          	 		0x01
 #define PORINT         		 	0x02
+#define WINDOW                  0x03     /* 窗函数: data = WIN_xxx (1 字节)，持久化到 Flash */
+#define RESOLUTION              0x04     /* 采集分辨率: data = 0 16 位 / 1 8 位，持久化到 Flash，重启采集 */
+#define TRIGGER                 0x05     /* 触发捕获: mode axis threshold_mg(u16) pre(u16)，设置即重新布防 */
+#define ADP                     0x06     /* 传感器内滤波: mode hpf_hz(u16) lpf_hz(u16)，持久化到 Flash，重启采集 */
 
 
-extern volatile uint8_t g_tx_busy;
 /* 上位机发来一帧后调用此函数，len=完整帧长度 */
 void Protocol_HandleRxFrame(const uint8_t *rx, uint16_t len, uint8_t local_address);
+void Protocol_BaudBoot(uint8_t idx);  // 上电时按 Flash 中的波特率启动 (调度器启动前)
+TickType_t Protocol_Poll(void);       // CommTask 每次等待前调用: 推进流式下载、处理波特率试用超时，返回下次等待的 tick 数
 
 
 #endif
@@ -0,0 +1,147 @@
+#include "trigger.h"
+#include "task.h"
+
+#define TRIG_RING_MASK  (TRIG_CAPTURE_LEN - 1)
+
+#if (TRIG_CAPTURE_LEN & TRIG_RING_MASK) != 0
+#error "TRIG_CAPTURE_LEN must be a power of 2"
+#endif
+
+static int16_t    s_TrigRing[TRIG_CAPTURE_LEN];   // 所选轴原始采样 (LSB)
+static TrigInfo_t s_Trig;
+static uint32_t   s_TrigWr = 0;         // 下一个写入位置
+static uint32_t   s_TrigStart = 0;      // 冻结后最早采样的位置
+static uint32_t   s_TrigFilled = 0;     // 布防后已写入的连续采样数 (饱和于 TRIG_CAPTURE_LEN)
+static uint32_t   s_TrigPost = 0;       // 触发后还需写入的采样数
+static int32_t    s_TrigBase = 0;       // LEVEL 模式基线
+static int32_t    s_TrigPrev = 0;       // SLOPE 模式上一个采样
+static uint8_t    s_TrigBaseValid = 0;
+
+// 重新布防: 历史作废，基线在下一块重新建立
+static void Trig_Arm(void)
+{
+    s_Trig.state = TRIG_STATE_ARMED;
+    s_Trig.flags = Acq_ConfigFlags();
+    s_Trig.odr = g_cfg_freq_hz;
+    s_TrigFilled = 0;
+    s_TrigBaseValid = 0;
+}
+
+void Trig_Config(uint8_t mode, uint8_t axis, uint16_t threshold_mg, uint16_t pre)
+{
+    if (mode >= TRIG_MODE_NUM || axis >= AXIS_COUNT || pre >= TRIG_CAPTURE_LEN) return;
+
+    uint32_t thr = (uint32_t)((float)threshold_mg * KX134_SENSITIVITY_LSB_G / 1000.0f);
+    if (thr == 0) thr = 1;
+    if (thr > 0xFFFF) thr = 0xFFFF;
+
+    taskENTER_CRITICAL();
+    s_Trig.mode = mode;
+    s_Trig.axis = axis;
+    s_Trig.threshold = (uint16_t)thr;
+    s_Trig.pre = pre;
+    s_Trig.len = TRIG_CAPTURE_LEN;
+    if (mode == TRIG_MODE_OFF) {
+        s_Trig.state = TRIG_STATE_IDLE;
+    } else {
+        Trig_Arm();
+    }
+    taskEXIT_CRITICAL();
+}
+
+void Trig_Reset(void)
+{
+    if (s_Trig.state == TRIG_STATE_ARMED || s_Trig.state == TRIG_STATE_POST) Trig_Arm();
+}
+
+void Trig_MarkGap(uint8_t flag)
+{
+    if (s_Trig.state == TRIG_STATE_ARMED) {
+        s_TrigFilled = 0;              // 历史不连续，重新攒
+        s_TrigBaseValid = 0;
+    } else if (s_Trig.state == TRIG_STATE_POST) {
+        s_Trig.flags |= flag;
+    }
+}
+
+void Trig_ProcessBlock(const int16_t *pFrame, uint32_t offset, uint32_t count, uint32_t firstSample)
+{
+    if (s_Trig.state != TRIG_STATE_ARMED && s_Trig.state != TRIG_STATE_POST) return;
+    if (count == 0) return;
+
+    const int16_t *src = RAW_AXIS(pFrame, s_Trig.axis) + offset;
+
+    if (s_Trig.mode == TRIG_MODE_LEVEL) {
+        int32_t sum = 0;
+        for (uint32_t i = 0; i < count; i++) sum += src[i];
+        int32_t mean = sum / (int32_t)count;
+        if (!s_TrigBaseValid) s_TrigBase = mean;
+        else s_TrigBase += (mean - s_TrigBase) >> TRIG_BASE_SHIFT;
+    } else if (!s_TrigBaseValid) {
+        s_TrigPrev = src[0];
+    }
+    s_TrigBaseValid = 1;
+
+    uint32_t w = s_TrigWr;
+    uint32_t i = 0;
+
+    // 布防: 写环并逐点比较，历史不足 pre 个时只写不比
+    if (s_Trig.state == TRIG_STATE_ARMED) {
+        const int32_t ref = s_TrigBase;
+        const int32_t thr = s_Trig.threshold;
+        const uint8_t slope = (s_Trig.mode == TRIG_MODE_SLOPE);
+        int32_t prev = s_TrigPrev;
+        for (; i < count; i++) {
+            int32_t x = src[i];
+            int32_t d = x - (slope ? prev : ref);
+            prev = x;
+            s_TrigRing[w] = (int16_t)x;
+            w = (w + 1) & TRIG_RING_MASK;
+            if (s_TrigFilled >= s_Trig.pre && (d > thr || d < -thr)) {
+                s_Trig.state = TRIG_STATE_POST;
+                s_Trig.trigSample = firstSample + i;
+                s_Trig.trigTick = xTaskGetTickCount();
+                s_TrigPost = TRIG_CAPTURE_LEN - s_Trig.pre - 1;   // 触发点本身算作第一个触发后采样
+                i++;
+                break;
+            }
+            if (s_TrigFilled < TRIG_CAPTURE_LEN) s_TrigFilled++;
+        }
+        s_TrigPrev = prev;
+    }
+
+    // 触发后: 只写环，写够即冻结
+    if (s_Trig.state == TRIG_STATE_POST) {
+        uint32_t n = count - i;
+        if (n > s_TrigPost) n = s_TrigPost;
+        for (uint32_t k = 0; k < n; k++) {
+            s_TrigRing[w] = src[i + k];
+            w = (w + 1) & TRIG_RING_MASK;
+        }
+        s_TrigPost -= n;
+        if (s_TrigPost == 0) {
+            s_TrigStart = w;               // 环正好写满一圈，最早的采样在写指针处
+            taskENTER_CRITICAL();
+            s_Trig.state = TRIG_STATE_READY;
+            taskEXIT_CRITICAL();
+        }
+    }
+    s_TrigWr = w;
+}
+
+void Trig_GetInfo(TrigInfo_t *out)
+{
+    taskENTER_CRITICAL();
+    *out = s_Trig;
+    taskEXIT_CRITICAL();
+}
+
+uint16_t Trig_Read(int16_t *out, uint16_t from, uint16_t n)
+{
+    if (s_Trig.state != TRIG_STATE_READY || from >= TRIG_CAPTURE_LEN) return 0;
+    if (n > TRIG_CAPTURE_LEN - from) n = TRIG_CAPTURE_LEN - from;
+    for (uint16_t i = 0; i < n; i++) {
+        out[i] = s_TrigRing[(s_TrigStart + from + i) & TRIG_RING_MASK];
+    }
+    return n;
+}
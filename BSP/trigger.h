@@ -0,0 +1,49 @@
+#ifndef __TRIGGER_H__
+#define __TRIGGER_H__
+
+#include "main.h"
+#include <stdint.h>
+
+/* ---- 触发采集 ----
+ * DataTask 每搬完一块调用 Trig_ProcessBlock: 所选轴的采样写入环形缓冲并逐点比较阈值。
+ * 预触发历史与触发后数据共用同一个环，触发后再写 TRIG_CAPTURE_LEN - pre 个采样即冻结，
+ * 冻结期间不再写入，上位机按时间顺序读取后重新布防 (CMD_CONFIG/TRIGGER)。
+ */
+#define TRIG_CAPTURE_LEN     1024     // 捕获长度 (采样，2 的幂)，单轴 int16 共 2KB
+#define TRIG_BASE_SHIFT      4        // LEVEL 模式基线按块均值跟踪，每块移动 1/16
+#define TRIG_PKT_POINTS      64       // 下载时每包点数 (与波形包相同)
+
+#define TRIG_MODE_OFF        0
+#define TRIG_MODE_LEVEL      1        // |a - 基线| > 阈值 (基线去掉重力与零偏)
+#define TRIG_MODE_SLOPE      2        // |a[n] - a[n-1]| > 阈值
+#define TRIG_MODE_NUM        3
+
+#define TRIG_STATE_IDLE      0        // 未启用
+#define TRIG_STATE_ARMED     1        // 已布防: 先攒满 pre 个历史采样，之后才允许触发
+#define TRIG_STATE_POST      2        // 已触发，正在采触发后数据
+#define TRIG_STATE_READY     3        // 捕获完成并冻结
+
+typedef struct {
+    uint8_t  state;         // TRIG_STATE_xxx
+    uint8_t  mode;          // TRIG_MODE_xxx
+    uint8_t  axis;          // 0 X 1 Y 2 Z
+    uint8_t  flags;         // ACQ_FLAG_xxx: 捕获期间的溢出/超时，8 位分辨率
+    uint16_t pre;           // 触发点之前的采样数
+    uint16_t len;           // 捕获长度，触发点为第 pre 个采样
+    uint16_t threshold;     // 阈值 (LSB)
+    uint16_t odr;           // 捕获时的 ODR (Hz)
+    uint32_t trigSample;    // 触发采样的全局序号 (与 AcqFrameInfo_t.firstSample 同一计数)
+    uint32_t trigTick;      // 触发所在块的 RTOS tick
+} TrigInfo_t;
+
+// 以下三个在 DataTask 中调用
+void Trig_ProcessBlock(const int16_t *pFrame, uint32_t offset, uint32_t count, uint32_t firstSample);
+void Trig_MarkGap(uint8_t flag);   // 发生溢出/超时: 布防中重新攒历史，触发后记入 flags
+void Trig_Reset(void);             // 采集重启 (改采样率/分辨率): 未完成的捕获重新布防，已冻结的保留
+
+// 以下在 CommTask 中调用 (DataTask 优先级更高，Trig_Config 以临界区与其互斥)
+void Trig_Config(uint8_t mode, uint8_t axis, uint16_t threshold_mg, uint16_t pre);   // 设置并重新布防，mode = OFF 停用
+void Trig_GetInfo(TrigInfo_t *out);
+uint16_t Trig_Read(int16_t *out, uint16_t from, uint16_t n);   // 按时间顺序读捕获 [from, from+n)，未冻结时返回 0
+
+#endif /* __TRIGGER_H__ */
@@ -0,0 +1,226 @@
+#include "uart_rx.h"
+#include "usart.h"
+#include "task.h"
+#include "queue.h"
+
+#define RX_UART        huart1
+#define RX_RING_MASK   (UART_RX_BUF_SIZE - 1)
+#define RX_MIN_FRAME   7          // dev cmd 3 字节参数 CRC
+#define RX_OTA_HDR     8          // OTA 数据帧 dev cmd offset(4) len(2)
+
+#if (UART_RX_BUF_SIZE & RX_RING_MASK) != 0
+#error "UART_RX_BUF_SIZE must be a power of 2"
+#endif
+
+typedef struct {
+    uint32_t start;          // 帧起点 (累计字节计数)
+    uint16_t len;
+} RxFrame_t;
+
+static uint8_t           s_RxRing[UART_RX_BUF_SIZE];   // DMA 循环写入
+static uint8_t           s_RxFrame[UART_RX_FRAME_MAX]; // CommTask 取出的当前帧
+static QueueHandle_t     s_RxFrameQ = NULL;
+static volatile uint32_t s_RxWr = 0;       // 累计写入字节数，环下标 = s_RxWr & RX_RING_MASK
+static uint32_t          s_RxStart = 0;    // 候选帧起点
+static uint32_t          s_RxIdle = 0;     // 最近一次 IDLE 时的写入位置 (之前的字节是收完的一段)
+static volatile uint8_t  s_RxStall = 0;    // 帧队列满，拆帧暂停到 CommTask 取走一帧
+static volatile uint8_t  s_RxKick = 0;     // CommTask 解除暂停，请 USART1 中断接着拆
+static UartRxStats_t     s_RxStats;
+
+static inline uint8_t rx_at(uint32_t pos)
+{
+    return s_RxRing[pos & RX_RING_MASK];
+}
+
+// Modbus CRC16 逐字节更新，与 Modbus_CRC16 相同
+static uint16_t rx_crc_byte(uint16_t crc, uint8_t b)
+{
+    crc ^= b;
+    for (uint8_t i = 0; i < 8; ++i) {
+        crc = (crc & 0x0001) ? (uint16_t)((crc >> 1) ^ 0xA001) : (uint16_t)(crc >> 1);
+    }
+    return crc;
+}
+
+// 从 s_RxStart 起 len 字节 (含末尾 CRC) 的帧 CRC 是否正确
+static uint8_t rx_crc_ok(uint32_t len)
+{
+    uint16_t crc = 0xFFFF;
+    for (uint32_t i = 0; i < len - 2; i++) crc = rx_crc_byte(crc, rx_at(s_RxStart + i));
+    return crc == (uint16_t)(rx_at(s_RxStart + len - 2) | (rx_at(s_RxStart + len - 1) << 8));
+}
+
+// DMA 当前写到的累计位置 (中断中或临界区内调用)
+static uint32_t rx_dma_pos(void)
+{
+    uint32_t idx = UART_RX_BUF_SIZE - __HAL_DMA_GET_COUNTER(RX_UART.hdmarx);
+    return s_RxWr + ((idx - s_RxWr) & RX_RING_MASK);
+}
+
+static void rx_skip(uint32_t n)
+{
+    s_RxStats.dropBytes += n;
+    s_RxStart += n;
+}
+
+// 帧队列满时不丢帧: 字节留在环里，返回 0 暂停拆帧
+static uint8_t rx_emit(uint32_t len, BaseType_t *woken)
+{
+    RxFrame_t f = { s_RxStart, (uint16_t)len };
+    if (xQueueSendFromISR(s_RxFrameQ, &f, woken) != pdTRUE) {
+        if (!s_RxStall) s_RxStats.stalls++;
+        s_RxStall = 1;
+        return 0;
+    }
+    s_RxStats.frames++;
+    s_RxStart += len;
+    return 1;
+}
+
+/* 普通命令的帧长 (0 = 无)。span 为可用字节数，final = span 止于 IDLE。
+ * 一段只有一帧时整段 CRC 正确即为帧；背靠背的多帧才按 CRC 拆: 取第一个之后还能放下一帧 (或正好到段尾) 的位置，
+ * 未到 IDLE 时帧尾必须在已收字节之内，等不到段尾就不认 */
+static uint32_t rx_match(uint32_t span, uint8_t final)
+{
+    if (span < RX_MIN_FRAME) return 0;
+    uint32_t lim = (span < UART_RX_SCAN_MAX) ? span : UART_RX_SCAN_MAX;
+    if (final && span <= UART_RX_SCAN_MAX && rx_crc_ok(span)) return span;
+
+    uint16_t crc = 0xFFFF;
+    for (uint32_t i = 0; i + 2 < lim; i++) {
+        crc = rx_crc_byte(crc, rx_at(s_RxStart + i));
+        uint32_t len = i + 3;
+        if (len < RX_MIN_FRAME) continue;
+        if (crc != (uint16_t)(rx_at(s_RxStart + len - 2) | (rx_at(s_RxStart + len - 1) << 8))) continue;
+        uint32_t rest = span - len;
+        if (final ? (rest == 0 || rest >= RX_MIN_FRAME) : (rest != 0)) return len;
+    }
+    return 0;
+}
+
+/* IDLE 为帧边界: 从 s_RxStart 到最近一次 IDLE 的字节是收完的一段，拆不出帧的整段丢弃 (不逐字节重新同步)；
+ * IDLE 之后仍在收的字节只拆出其中已完整的背靠背帧。OTA 数据帧按头部长度定长，跨 IDLE 也等齐 */
+static void rx_parse(BaseType_t *woken)
+{
+    while (!s_RxStall) {
+        uint32_t avail = s_RxWr - s_RxStart;
+        uint32_t span = s_RxIdle - s_RxStart;
+        uint8_t final = (span != 0 && span <= avail);
+        if (!final) span = avail;
+        if (span == 0) break;
+
+        // OTA 数据帧: offset/长度须 4 字节对齐，否则视为乱码
+        if (span >= 2 && rx_at(s_RxStart + 1) == CMD_OTA_DATA) {
+            if (avail < RX_OTA_HDR) break;
+            uint32_t dlen = ((uint32_t)rx_at(s_RxStart + 6) << 8) | rx_at(s_RxStart + 7);
+            uint32_t len = RX_OTA_HDR + dlen + 2;
+            if (dlen == 0 || (dlen & 3) || (rx_at(s_RxStart + 5) & 3) || len > UART_RX_FRAME_MAX) {
+                rx_skip(span);
+                continue;
+            }
+            if (avail < len) break;
+            if (!rx_crc_ok(len)) { rx_skip(final && span > len ? span : len); continue; }
+            if (!rx_emit(len, woken)) break;
+            continue;
+        }
+
+        // 其余命令
+        uint32_t len = rx_match(span, final);
+        if (len) {
+            if (!rx_emit(len, woken)) break;
+            continue;
+        }
+        if (final || avail > UART_RX_SCAN_MAX) { rx_skip(span); continue; }   // 开头不是帧，丢到下一次 IDLE
+        break;
+    }
+}
+
+static void rx_update(uint8_t idle)
+{
+    uint32_t wr = rx_dma_pos();
+    s_RxStats.bytes += wr - s_RxWr;
+    s_RxWr = wr;
+    if (idle) s_RxIdle = wr;
+    if (wr - s_RxStart > UART_RX_BUF_SIZE) {    // 拆帧暂停期间积压超过整环，未拆的字节已被覆盖
+        s_RxStats.dropBytes += wr - s_RxStart;
+        s_RxStart = wr;
+    }
+
+    BaseType_t woken = pdFALSE;
+    rx_parse(&woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+void UartRx_Init(void)
+{
+    s_RxFrameQ = xQueueCreate(UART_RX_QUEUE_N, sizeof(RxFrame_t));
+}
+
+void UartRx_Start(void)
+{
+    // DMA 从环首重新写: 计数进到下一个整环，队列中旧帧的覆盖判断仍然成立
+    s_RxWr = (s_RxWr + RX_RING_MASK) & ~(uint32_t)RX_RING_MASK;
+    s_RxStart = s_RxWr;
+    s_RxIdle = s_RxWr;
+    __HAL_UART_CLEAR_IDLEFLAG(&RX_UART);          // 清一次 IDLE 残留
+    __HAL_UART_ENABLE_IT(&RX_UART, UART_IT_IDLE);
+    HAL_UART_Receive_DMA(&RX_UART, s_RxRing, UART_RX_BUF_SIZE);
+}
+
+const uint8_t *UartRx_Receive(uint16_t *len, TickType_t wait)
+{
+    RxFrame_t f;
+    if (xQueueReceive(s_RxFrameQ, &f, wait) != pdTRUE) return NULL;
+
+    for (uint16_t i = 0; i < f.len; i++) s_RxFrame[i] = rx_at(f.start + i);
+
+    // 拷贝完成时 DMA 若已写过帧起点一整环，说明拷出的内容不完整
+    taskENTER_CRITICAL();
+    uint32_t wr = rx_dma_pos();
+    uint8_t kick = s_RxStall;
+    if (kick) {                           // 队列有空位了，由 USART1 中断接着拆暂停时积压的字节
+        s_RxStall = 0;
+        s_RxKick = 1;
+    }
+    taskEXIT_CRITICAL();
+    if (kick) HAL_NVIC_SetPendingIRQ(USART1_IRQn);
+    if (wr - f.start > UART_RX_BUF_SIZE) {
+        s_RxStats.overwritten++;
+        return NULL;
+    }
+    *len = f.len;
+    return s_RxFrame;
+}
+
+void UartRx_GetStats(UartRxStats_t *out)
+{
+    taskENTER_CRITICAL();
+    *out = s_RxStats;
+    taskEXIT_CRITICAL();
+}
+
+void UartRx_IdleFromISR(void)
+{
+    rx_update(1);
+}
+
+void UartRx_DmaFromISR(void)
+{
+    rx_update(0);
+}
+
+void UartRx_KickFromISR(void)
+{
+    if (!s_RxKick) return;
+    s_RxKick = 0;
+    rx_update(0);
+}
+
+void UartRx_ErrorFromISR(void)
+{
+    // 接收错误时 HAL 结束接收并中止 DMA (RxState 回到 READY)，先拆完已收到的再从环首重启
+    if (RX_UART.RxState != HAL_UART_STATE_READY) return;
+    s_RxStats.errors++;
+    rx_update(1);                         // 出错处视为一段的结束
+    UartRx_Start();
+}
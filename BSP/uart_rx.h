@@ -0,0 +1,38 @@
+#ifndef __UART_RX_H__
+#define __UART_RX_H__
+
+#include "main.h"
+#include <stdint.h>
+
+/* ---- 串口接收环 ----
+ * USART1 接收 DMA 工作在循环模式，收到的字节连续写入 UART_RX_BUF_SIZE 字节的环，不再停止/重启。
+ * IDLE 中断与 DMA 半满/全满中断读取写指针，对新到的字节增量拆帧。IDLE 为帧边界，两次 IDLE 之间的一段通常就是一帧；
+ * 背靠背连发的多帧在 UART_RX_SCAN_MAX 字节内按 CRC 拆开，OTA 数据帧按头部长度定长，拆不出帧的一段整段丢弃。
+ * 拆出的帧以 (起点, 长度) 放入帧队列，CommTask 取出时再从环中拷出，连发的多帧依次处理，不会互相覆盖。
+ * 帧队列满时拆帧暂停，CommTask 取走一帧后软件触发 USART1 中断接着拆，只有积压超过整环时才会丢数据 (计入 overwritten/dropBytes)。
+ */
+#define UART_RX_FRAME_MAX     (2 + 6 + 256 + 2)   // 最长帧: OTA 数据帧 dev cmd offset(4) len(2) 256 字节 CRC
+#define UART_RX_SCAN_MAX      32                  // 其余命令的帧长上限
+#define UART_RX_QUEUE_N       8                   // 帧队列深度
+
+typedef struct {
+    uint32_t bytes;         // 收到字节数
+    uint32_t frames;        // 拆出的帧数
+    uint32_t dropBytes;     // 无法成帧 (CRC 不对/长度非法) 整段丢弃的字节数
+    uint32_t stalls;        // 帧队列满、拆帧暂停的次数 (字节留在环里，不丢)
+    uint32_t overwritten;   // 取出前已被新数据覆盖的帧数 (环溢出)
+    uint32_t errors;        // 接收错误 (噪声/帧错误/溢出) 后重启 DMA 的次数
+} UartRxStats_t;
+
+void UartRx_Init(void);                  // 启动接收之前调用 (可在调度器启动前)
+void UartRx_Start(void);                 // 启动循环 DMA 接收，未成帧的数据作废 (上电、改波特率)
+const uint8_t *UartRx_Receive(uint16_t *len, TickType_t wait);  // 等下一帧，超时返回 NULL；返回的缓冲在下次调用前有效
+void UartRx_GetStats(UartRxStats_t *out);
+
+// 以下在中断中调用
+void UartRx_IdleFromISR(void);           // USART1 IDLE 中断: 线路空闲，现有字节不会再有后续
+void UartRx_DmaFromISR(void);            // HAL_UART_RxHalfCpltCallback / HAL_UART_RxCpltCallback
+void UartRx_KickFromISR(void);           // USART1 中断入口: 帧队列腾出空位后 (UartRx_Receive 软件触发本中断) 接着拆帧
+void UartRx_ErrorFromISR(void);          // HAL_UART_ErrorCallback: 接收错误使 HAL 停了 DMA 时重启
+
+#endif /* __UART_RX_H__ */
@@ -0,0 +1,162 @@
+#include "uart_tx.h"
+#include "usart.h"
+#include "task.h"
+#include "queue.h"
+
+#define TX_UART      huart1
+#define TX_NONE      0xFF
+
+typedef struct {
+    uint8_t  idx;            // 池中缓冲编号
+    uint16_t len;
+} TxItem_t;
+
+static uint8_t           s_TxPool[UART_TX_POOL_N][UART_TX_BUF_SIZE];
+static QueueHandle_t     s_TxFreeQ = NULL;      // 空闲缓冲编号
+static QueueHandle_t     s_TxPendQ = NULL;      // 待发帧 (FIFO)
+static SemaphoreHandle_t s_TxDoneSem = NULL;    // 有任务在 UartTx_Wait 时由中断给出
+static volatile uint8_t  s_TxCur = TX_NONE;     // 正在 DMA 发送的缓冲
+static volatile uint16_t s_TxCurLen = 0;
+static volatile uint32_t s_TxDone = 0;          // 已结束 (发完或作废) 的帧数，与提交序号同一计数
+static volatile uint8_t  s_TxWaiting = 0;
+static UartTxStats_t     s_TxStats;
+
+void UartTx_Init(void)
+{
+    s_TxFreeQ = xQueueCreate(UART_TX_POOL_N, sizeof(uint8_t));
+    s_TxPendQ = xQueueCreate(UART_TX_POOL_N, sizeof(TxItem_t));
+    s_TxDoneSem = xSemaphoreCreateBinary();
+    for (uint8_t i = 0; i < UART_TX_POOL_N; i++) xQueueSend(s_TxFreeQ, &i, 0);
+    s_TxStats.freeMin = UART_TX_POOL_N;
+}
+
+// 当前帧结束: 归还缓冲
+static void tx_finish_cur(BaseType_t *woken)
+{
+    uint8_t idx = s_TxCur;
+    s_TxCur = TX_NONE;
+    xQueueSendFromISR(s_TxFreeQ, &idx, woken);
+    s_TxDone++;
+}
+
+// 发送器空闲时取队首帧启动 DMA；中断或临界区内调用
+static void tx_start_next(BaseType_t *woken)
+{
+    TxItem_t it;
+    while (s_TxCur == TX_NONE && xQueueReceiveFromISR(s_TxPendQ, &it, woken) == pdTRUE) {
+        s_TxCur = it.idx;
+        s_TxCurLen = it.len;
+        if (HAL_UART_Transmit_DMA(&TX_UART, s_TxPool[it.idx], it.len) != HAL_OK) {
+            s_TxStats.dmaErrors++;
+            tx_finish_cur(woken);
+        }
+    }
+}
+
+static void tx_notify_waiter(BaseType_t *woken)
+{
+    if (s_TxWaiting) {
+        s_TxWaiting = 0;
+        xSemaphoreGiveFromISR(s_TxDoneSem, woken);
+    }
+}
+
+uint8_t *UartTx_Alloc(TickType_t wait)
+{
+    uint8_t idx;
+    if (xQueueReceive(s_TxFreeQ, &idx, 0) != pdTRUE) {
+        s_TxStats.allocWaits++;
+        if (wait == 0 || xQueueReceive(s_TxFreeQ, &idx, wait) != pdTRUE) {
+            s_TxStats.allocFails++;
+            return NULL;
+        }
+    }
+    uint8_t nfree = (uint8_t)uxQueueMessagesWaiting(s_TxFreeQ);
+    if (nfree < s_TxStats.freeMin) s_TxStats.freeMin = nfree;
+    return s_TxPool[idx];
+}
+
+static uint8_t tx_buf_index(const uint8_t *buf)
+{
+    uint32_t off = (uint32_t)(buf - &s_TxPool[0][0]);
+    return (uint8_t)(off / UART_TX_BUF_SIZE);
+}
+
+void UartTx_Release(uint8_t *buf)
+{
+    uint8_t idx = tx_buf_index(buf);
+    xQueueSend(s_TxFreeQ, &idx, 0);
+}
+
+uint32_t UartTx_Submit(uint8_t *buf, uint16_t len)
+{
+    TxItem_t it = { tx_buf_index(buf), len };
+    if (len == 0 || len > UART_TX_BUF_SIZE) {
+        UartTx_Release(buf);
+        return 0;
+    }
+
+    uint32_t ticket;
+    taskENTER_CRITICAL();
+    xQueueSend(s_TxPendQ, &it, 0);          // 队列长度等于缓冲数，不会满
+    ticket = ++s_TxStats.submitted;
+    uint8_t nq = (uint8_t)uxQueueMessagesWaiting(s_TxPendQ);
+    if (nq > s_TxStats.queuedMax) s_TxStats.queuedMax = nq;
+    tx_start_next(NULL);
+    taskEXIT_CRITICAL();
+    return ticket;
+}
+
+uint8_t UartTx_Wait(uint32_t ticket, TickType_t wait)
+{
+    TickType_t start = xTaskGetTickCount();
+    for (;;) {
+        taskENTER_CRITICAL();
+        uint8_t done = ((int32_t)(s_TxDone - ticket) >= 0);
+        if (!done) s_TxWaiting = 1;
+        taskEXIT_CRITICAL();
+        if (done) return 1;
+
+        TickType_t elapsed = xTaskGetTickCount() - start;
+        if (elapsed >= wait) return 0;
+        xSemaphoreTake(s_TxDoneSem, wait - elapsed);   // 之前残留的信号只会多循环一次
+    }
+}
+
+uint8_t UartTx_Flush(TickType_t wait)
+{
+    return UartTx_Wait(s_TxStats.submitted, wait);
+}
+
+void UartTx_GetStats(UartTxStats_t *out)
+{
+    taskENTER_CRITICAL();
+    *out = s_TxStats;
+    taskEXIT_CRITICAL();
+}
+
+void UartTx_TxCpltFromISR(void)
+{
+    BaseType_t woken = pdFALSE;
+    if (s_TxCur != TX_NONE) {
+        s_TxStats.sent++;
+        s_TxStats.bytes += s_TxCurLen;
+        tx_finish_cur(&woken);
+    }
+    tx_start_next(&woken);
+    tx_notify_waiter(&woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+void UartTx_ErrorFromISR(void)
+{
+    // 只处理 DMA 发送被 HAL 中止的情况 (gState 已回到 READY 而当前帧未完成)，接收错误不影响发送
+    if (s_TxCur == TX_NONE || TX_UART.gState != HAL_UART_STATE_READY) return;
+
+    BaseType_t woken = pdFALSE;
+    s_TxStats.dmaErrors++;
+    tx_finish_cur(&woken);
+    tx_start_next(&woken);
+    tx_notify_waiter(&woken);
+    portYIELD_FROM_ISR(woken);
+}
@@ -0,0 +1,39 @@
+#ifndef __UART_TX_H__
+#define __UART_TX_H__
+
+#include "main.h"
+#include <stdint.h>
+
+/* ---- 串口发送队列 ----
+ * 固定数量的帧缓冲 (池) + FreeRTOS 待发队列。任务申请缓冲、填帧、提交后立即返回；
+ * 发送完成中断归还缓冲并直接启动队列中的下一帧，帧间不经过任务调度。
+ * 池空时 UartTx_Alloc 按给定时间阻塞 (反压)，需要确认发完的调用者用提交返回的序号 UartTx_Wait。
+ */
+#define UART_TX_POOL_N          4        // 帧缓冲数 (流式下载时 1 个在发、其余排队)
+#define UART_TX_BUF_SIZE        264      // 单帧上限: 长记录包 6 + 256 + 2
+#define UART_TX_ALLOC_WAIT_MS   50       // 普通应答申请缓冲的最长等待
+
+typedef struct {
+    uint32_t submitted;     // 提交帧数 (即最近一次提交的序号)
+    uint32_t sent;          // 发送完成帧数
+    uint32_t bytes;         // 发送完成字节数
+    uint32_t allocWaits;    // 申请时池已空、需要等待的次数
+    uint32_t allocFails;    // 等待超时仍无缓冲的次数 (该帧未发送)
+    uint32_t dmaErrors;     // 启动 DMA 失败或发送中出错的帧数
+    uint8_t  freeMin;       // 空闲缓冲历史最小值
+    uint8_t  queuedMax;     // 排队帧数历史最大值 (不含正在发送的一帧)
+} UartTxStats_t;
+
+void UartTx_Init(void);                                  // 创建任务之前调用
+uint8_t *UartTx_Alloc(TickType_t wait);                  // 申请 UART_TX_BUF_SIZE 字节的帧缓冲，超时返回 NULL
+void UartTx_Release(uint8_t *buf);                       // 申请后不发送时归还
+uint32_t UartTx_Submit(uint8_t *buf, uint16_t len);      // 提交填好的帧 (缓冲随之交出)，不阻塞；返回序号，0 = 失败
+uint8_t UartTx_Wait(uint32_t ticket, TickType_t wait);   // 等序号 ticket 及之前的帧全部发完，超时返回 0
+uint8_t UartTx_Flush(TickType_t wait);                   // 等已提交的帧全部发完 (改波特率、复位前)
+void UartTx_GetStats(UartTxStats_t *out);
+
+// 以下在 USART1 中断回调中调用
+void UartTx_TxCpltFromISR(void);                         // HAL_UART_TxCpltCallback
+void UartTx_ErrorFromISR(void);                          // HAL_UART_ErrorCallback: DMA 发送被 HAL 中止时作废当前帧
+
+#endif /* __UART_TX_H__ */
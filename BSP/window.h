@@ -0,0 +1,40 @@
+#ifndef __WINDOW_H__
+#define __WINDOW_H__
+
+#include "arm_math.h"
+#include <stddef.h>
+
+/* ---- 窗函数编号 (持久化在 flash_dev_cfg_t.window，协议 CMD_CONFIG/WINDOW 设置) ---- */
+#define WIN_RECT              0     // 矩形窗 (不加窗)
+#define WIN_HANN              1
+#define WIN_HAMMING           2
+#define WIN_FLATTOP           3     // 平顶窗，幅值扇贝损失 < 0.01 dB
+#define WIN_BLACKMAN_HARRIS   4     // 4 项 Blackman-Harris，旁瓣 -92 dB
+#define WIN_TYPE_NUM          5
+#define WIN_DEFAULT           WIN_HANN
+
+/* ---- 窗表 (window_tables.c，由 gen_window_tables.py 生成) ---- */
+#define WIN_TABLE_LEN         4096  // 表对应的最长 FFT，L 点 FFT 按步长 WIN_TABLE_LEN / L 取样
+#define WIN_MAX_TERMS         4     // 余弦和窗除 a0 外的最大项数
+#define WIN_Q15_SCALE         (1.0f / 32767.0f)
+
+typedef struct
+{
+    const q15_t *half;                 // w[0..WIN_TABLE_LEN/2]，NULL = 矩形窗
+    float32_t    cg;                   // 相干增益 mean(w)，正弦幅值修正 = 1/cg
+    float32_t    pg;                   // 能量增益 mean(w²)，由谱求 RMS 的功率修正 = 1/pg
+    float32_t    ratio[WIN_MAX_TERMS]; // (-1)^m * a_m / a0，用于计算偏离 bin 中心时的幅度响应
+} WinInfo_t;
+
+extern const WinInfo_t g_WinInfo[WIN_TYPE_NUM];
+
+// L 点窗第 n 个值，stride = WIN_TABLE_LEN / L
+static inline float32_t Win_Value(const WinInfo_t *w, uint32_t n, uint32_t stride)
+{
+    uint32_t i = n * stride;
+    if (w->half == NULL) return 1.0f;
+    if (i > WIN_TABLE_LEN / 2) i = WIN_TABLE_LEN - i;
+    return (float32_t)w->half[i] * WIN_Q15_SCALE;
+}
+
+#endif /* __WINDOW_H__ */
@@ -0,0 +1,714 @@
+/* 由 gen_window_tables.py 生成，请勿手工修改 */
+#include "window.h"
+
+#if WIN_TABLE_LEN != 4096
+#error "window_tables.c is out of date, rerun gen_window_tables.py"
+#endif
+
+/* Hann: a0=0.5, a1=0.5 */
+static const q15_t s_WinHann[WIN_TABLE_LEN / 2 + 1] = {
+         0,      0,      0,      0,      0,      0,      1,      1,      1,      2,      2,      2,
+         3,      3,      4,      4,      5,      6,      6,      7,      8,      8,      9,     10,
+        11,     12,     13,     14,     15,     16,     17,     19,     20,     21,     22,     24,
+        25,     26,     28,     29,     31,     32,     34,     36,     37,     39,     41,     43,
+        44,     46,     48,     50,     52,     54,     56,     58,     60,     63,     65,     67,
+        69,     72,     74,     76,     79,     81,     84,     86,     89,     92,     94,     97,
+       100,    103,    105,    108,    111,    114,    117,    120,    123,    126,    129,    133,
+       136,    139,    142,    146,    149,    152,    156,    159,    163,    166,    170,    174,
+       177,    181,    185,    189,    192,    196,    200,    204,    208,    212,    216,    220,
+       224,    228,    233,    237,    241,    246,    250,    254,    259,    263,    268,    272,
+       277,    281,    286,    291,    295,    300,    305,    310,    315,    320,    325,    330,
+       335,    340,    345,    350,    355,    360,    366,    371,    376,    382,    387,    393,
+       398,    404,    409,    415,    420,    426,    432,    438,    443,    449,    455,    461,
+       467,    473,    479,    485,    491,    497,    503,    509,    516,    522,    528,    535,
+       541,    547,    554,    560,    567,    574,    580,    587,    593,    600,    607,    614,
+       621,    627,    634,    641,    648,    655,    662,    669,    677,    684,    691,    698,
+       705,    713,    720,    728,    735,    742,    750,    757,    765,    773,    780,    788,
+       796,    803,    811,    819,    827,    835,    843,    851,    859,    867,    875,    883,
+       891,    899,    908,    916,    924,    932,    941,    949,    958,    966,    975,    983,
+       992,   1000,   1009,   1018,   1027,   1035,   1044,   1053,   1062,   1071,   1080,   1089,
+      1098,   1107,   1116,   1125,   1134,   1143,   1153,   1162,   1171,   1181,   1190,   1199,
+      1209,   1218,   1228,   1238,   1247,   1257,   1266,   1276,   1286,   1296,   1305,   1315,
+      1325,   1335,   1345,   1355,   1365,   1375,   1385,   1395,   1406,   1416,   1426,   1436,
+      1447,   1457,   1467,   1478,   1488,   1499,   1509,   1520,   1530,   1541,   1552,   1562,
+      1573,   1584,   1595,   1605,   1616,   1627,   1638,   1649,   1660,   1671,   1682,   1693,
+      1704,   1716,   1727,   1738,   1749,   1761,   1772,   1783,   1795,   1806,   1818,   1829,
+      1841,   1852,   1864,   1876,   1887,   1899,   1911,   1923,   1935,   1946,   1958,   1970,
+      1982,   1994,   2006,   2018,   2030,   2043,   2055,   2067,   2079,   2091,   2104,   2116,
+      2128,   2141,   2153,   2166,   2178,   2191,   2203,   2216,   2229,   2241,   2254,   2267,
+      2279,   2292,   2305,   2318,   2331,   2344,   2357,   2370,   2383,   2396,   2409,   2422,
+      2435,   2449,   2462,   2475,   2488,   2502,   2515,   2528,   2542,   2555,   2569,   2582,
+      2596,   2609,   2623,   2637,   2650,   2664,   2678,   2692,   2706,   2719,   2733,   2747,
+      2761,   2775,   2789,   2803,   2817,   2831,   2845,   2860,   2874,   2888,   2902,   2917,
+      2931,   2945,   2960,   2974,   2989,   3003,   3018,   3032,   3047,   3061,   3076,   3091,
+      3105,   3120,   3135,   3150,   3165,   3179,   3194,   3209,   3224,   3239,   3254,   3269,
+      3284,   3299,   3315,   3330,   3345,   3360,   3375,   3391,   3406,   3421,   3437,   3452,
+      3468,   3483,   3499,   3514,   3530,   3545,   3561,   3577,   3592,   3608,   3624,   3640,
+      3655,   3671,   3687,   3703,   3719,   3735,   3751,   3767,   3783,   3799,   3815,   3831,
+      3847,   3864,   3880,   3896,   3912,   3929,   3945,   3961,   3978,   3994,   4011,   4027,
+      4044,   4060,   4077,   4093,   4110,   4127,   4143,   4160,   4177,   4194,   4210,   4227,
+      4244,   4261,   4278,   4295,   4312,   4329,   4346,   4363,   4380,   4397,   4414,   4432,
+      4449,   4466,   4483,   4500,   4518,   4535,   4553,   4570,   4587,   4605,   4622,   4640,
+      4657,   4675,   4692,   4710,   4728,   4745,   4763,   4781,   4799,   4816,   4834,   4852,
+      4870,   4888,   4906,   4924,   4942,   4960,   4978,   4996,   5014,   5032,   5050,   5068,
+      5086,   5105,   5123,   5141,   5159,   5178,   5196,   5214,   5233,   5251,   5270,   5288,
+      5307,   5325,   5344,   5362,   5381,   5400,   5418,   5437,   5456,   5474,   5493,   5512,
+      5531,   5550,   5569,   5587,   5606,   5625,   5644,   5663,   5682,   5701,   5720,   5739,
+      5759,   5778,   5797,   5816,   5835,   5855,   5874,   5893,   5912,   5932,   5951,   5971,
+      5990,   6009,   6029,   6048,   6068,   6087,   6107,   6127,   6146,   6166,   6185,   6205,
+      6225,   6245,   6264,   6284,   6304,   6324,   6344,   6363,   6383,   6403,   6423,   6443,
+      6463,   6483,   6503,   6523,   6543,   6563,   6584,   6604,   6624,   6644,   6664,   6685,
+      6705,   6725,   6745,   6766,   6786,   6806,   6827,   6847,   6868,   6888,   6909,   6929,
+      6950,   6970,   6991,   7011,   7032,   7053,   7073,   7094,   7115,   7136,   7156,   7177,
+      7198,   7219,   7240,   7260,   7281,   7302,   7323,   7344,   7365,   7386,   7407,   7428,
+      7449,   7470,   7491,   7512,   7534,   7555,   7576,   7597,   7618,   7640,   7661,   7682,
+      7703,   7725,   7746,   7767,   7789,   7810,   7832,   7853,   7875,   7896,   7918,   7939,
+      7961,   7982,   8004,   8025,   8047,   8069,   8090,   8112,   8134,   8156,   8177,   8199,
+      8221,   8243,   8264,   8286,   8308,   8330,   8352,   8374,   8396,   8418,   8440,   8462,
+      8484,   8506,   8528,   8550,   8572,   8594,   8616,   8638,   8660,   8683,   8705,   8727,
+      8749,   8771,   8794,   8816,   8838,   8861,   8883,   8905,   8928,   8950,   8972,   8995,
+      9017,   9040,   9062,   9085,   9107,   9130,   9152,   9175,   9197,   9220,   9243,   9265,
+      9288,   9311,   9333,   9356,   9379,   9401,   9424,   9447,   9470,   9492,   9515,   9538,
+      9561,   9584,   9607,   9630,   9652,   9675,   9698,   9721,   9744,   9767,   9790,   9813,
+      9836,   9859,   9882,   9905,   9929,   9952,   9975,   9998,  10021,  10044,  10067,  10091,
+     10114,  10137,  10160,  10184,  10207,  10230,  10253,  10277,  10300,  10323,  10347,  10370,
+     10393,  10417,  10440,  10464,  10487,  10511,  10534,  10558,  10581,  10605,  10628,  10652,
+     10675,  10699,  10722,  10746,  10770,  10793,  10817,  10840,  10864,  10888,  10911,  10935,
+     10959,  10983,  11006,  11030,  11054,  11078,  11101,  11125,  11149,  11173,  11197,  11220,
+     11244,  11268,  11292,  11316,  11340,  11364,  11388,  11412,  11436,  11460,  11484,  11508,
+     11532,  11556,  11580,  11604,  11628,  11652,  11676,  11700,  11724,  11748,  11772,  11796,
+     11820,  11845,  11869,  11893,  11917,  11941,  11965,  11990,  12014,  12038,  12062,  12087,
+     12111,  12135,  12159,  12184,  12208,  12232,  12257,  12281,  12305,  12330,  12354,  12378,
+     12403,  12427,  12451,  12476,  12500,  12525,  12549,  12574,  12598,  12622,  12647,  12671,
+     12696,  12720,  12745,  12769,  12794,  12818,  12843,  12867,  12892,  12917,  12941,  12966,
+     12990,  13015,  13039,  13064,  13089,  13113,  13138,  13163,  13187,  13212,  13237,  13261,
+     13286,  13311,  13335,  13360,  13385,  13409,  13434,  13459,  13484,  13508,  13533,  13558,
+     13583,  13607,  13632,  13657,  13682,  13706,  13731,  13756,  13781,  13806,  13830,  13855,
+     13880,  13905,  13930,  13955,  13980,  14004,  14029,  14054,  14079,  14104,  14129,  14154,
+     14179,  14204,  14228,  14253,  14278,  14303,  14328,  14353,  14378,  14403,  14428,  14453,
+     14478,  14503,  14528,  14553,  14578,  14603,  14628,  14653,  14678,  14703,  14728,  14753,
+     14778,  14803,  14828,  14853,  14878,  14903,  14928,  14953,  14978,  15003,  15028,  15053,
+     15078,  15103,  15128,  15153,  15178,  15203,  15228,  15253,  15279,  15304,  15329,  15354,
+     15379,  15404,  15429,  15454,  15479,  15504,  15529,  15554,  15580,  15605,  15630,  15655,
+     15680,  15705,  15730,  15755,  15780,  15806,  15831,  15856,  15881,  15906,  15931,  15956,
+     15981,  16007,  16032,  16057,  16082,  16107,  16132,  16157,  16182,  16208,  16233,  16258,
+     16283,  16308,  16333,  16358,  16383,  16409,  16434,  16459,  16484,  16509,  16534,  16559,
+     16585,  16610,  16635,  16660,  16685,  16710,  16735,  16760,  16786,  16811,  16836,  16861,
+     16886,  16911,  16936,  16961,  16987,  17012,  17037,  17062,  17087,  17112,  17137,  17162,
+     17187,  17213,  17238,  17263,  17288,  17313,  17338,  17363,  17388,  17413,  17438,  17463,
+     17488,  17514,  17539,  17564,  17589,  17614,  17639,  17664,  17689,  17714,  17739,  17764,
+     17789,  17814,  17839,  17864,  17889,  17914,  17939,  17964,  17989,  18014,  18039,  18064,
+     18089,  18114,  18139,  18164,  18189,  18214,  18239,  18264,  18289,  18314,  18339,  18364,
+     18389,  18414,  18439,  18464,  18489,  18514,  18539,  18563,  18588,  18613,  18638,  18663,
+     18688,  18713,  18738,  18763,  18787,  18812,  18837,  18862,  18887,  18912,  18937,  18961,
+     18986,  19011,  19036,  19061,  19085,  19110,  19135,  19160,  19184,  19209,  19234,  19259,
+     19283,  19308,  19333,  19358,  19382,  19407,  19432,  19456,  19481,  19506,  19530,  19555,
+     19580,  19604,  19629,  19654,  19678,  19703,  19728,  19752,  19777,  19801,  19826,  19850,
+     19875,  19900,  19924,  19949,  19973,  19998,  20022,  20047,  20071,  20096,  20120,  20145,
+     20169,  20193,  20218,  20242,  20267,  20291,  20316,  20340,  20364,  20389,  20413,  20437,
+     20462,  20486,  20510,  20535,  20559,  20583,  20608,  20632,  20656,  20680,  20705,  20729,
+     20753,  20777,  20802,  20826,  20850,  20874,  20898,  20922,  20947,  20971,  20995,  21019,
+     21043,  21067,  21091,  21115,  21139,  21163,  21187,  21211,  21235,  21259,  21283,  21307,
+     21331,  21355,  21379,  21403,  21427,  21451,  21475,  21499,  21523,  21547,  21570,  21594,
+     21618,  21642,  21666,  21689,  21713,  21737,  21761,  21784,  21808,  21832,  21856,  21879,
+     21903,  21927,  21950,  21974,  21997,  22021,  22045,  22068,  22092,  22115,  22139,  22162,
+     22186,  22209,  22233,  22256,  22280,  22303,  22327,  22350,  22374,  22397,  22420,  22444,
+     22467,  22490,  22514,  22537,  22560,  22583,  22607,  22630,  22653,  22676,  22700,  22723,
+     22746,  22769,  22792,  22815,  22838,  22862,  22885,  22908,  22931,  22954,  22977,  23000,
+     23023,  23046,  23069,  23092,  23115,  23137,  23160,  23183,  23206,  23229,  23252,  23275,
+     23297,  23320,  23343,  23366,  23388,  23411,  23434,  23456,  23479,  23502,  23524,  23547,
+     23570,  23592,  23615,  23637,  23660,  23682,  23705,  23727,  23750,  23772,  23795,  23817,
+     23839,  23862,  23884,  23906,  23929,  23951,  23973,  23996,  24018,  24040,  24062,  24084,
+     24107,  24129,  24151,  24173,  24195,  24217,  24239,  24261,  24283,  24305,  24327,  24349,
+     24371,  24393,  24415,  24437,  24459,  24481,  24503,  24524,  24546,  24568,  24590,  24611,
+     24633,  24655,  24677,  24698,  24720,  24742,  24763,  24785,  24806,  24828,  24849,  24871,
+     24892,  24914,  24935,  24957,  24978,  25000,  25021,  25042,  25064,  25085,  25106,  25127,
+     25149,  25170,  25191,  25212,  25233,  25255,  25276,  25297,  25318,  25339,  25360,  25381,
+     25402,  25423,  25444,  25465,  25486,  25507,  25527,  25548,  25569,  25590,  25611,  25631,
+     25652,  25673,  25694,  25714,  25735,  25756,  25776,  25797,  25817,  25838,  25858,  25879,
+     25899,  25920,  25940,  25961,  25981,  26001,  26022,  26042,  26062,  26082,  26103,  26123,
+     26143,  26163,  26183,  26204,  26224,  26244,  26264,  26284,  26304,  26324,  26344,  26364,
+     26384,  26404,  26423,  26443,  26463,  26483,  26503,  26522,  26542,  26562,  26582,  26601,
+     26621,  26640,  26660,  26680,  26699,  26719,  26738,  26758,  26777,  26796,  26816,  26835,
+     26855,  26874,  26893,  26912,  26932,  26951,  26970,  26989,  27008,  27028,  27047,  27066,
+     27085,  27104,  27123,  27142,  27161,  27180,  27198,  27217,  27236,  27255,  27274,  27293,
+     27311,  27330,  27349,  27367,  27386,  27405,  27423,  27442,  27460,  27479,  27497,  27516,
+     27534,  27553,  27571,  27589,  27608,  27626,  27644,  27662,  27681,  27699,  27717,  27735,
+     27753,  27771,  27789,  27807,  27825,  27843,  27861,  27879,  27897,  27915,  27933,  27951,
+     27968,  27986,  28004,  28022,  28039,  28057,  28075,  28092,  28110,  28127,  28145,  28162,
+     28180,  28197,  28214,  28232,  28249,  28267,  28284,  28301,  28318,  28335,  28353,  28370,
+     28387,  28404,  28421,  28438,  28455,  28472,  28489,  28506,  28523,  28540,  28557,  28573,
+     28590,  28607,  28624,  28640,  28657,  28674,  28690,  28707,  28723,  28740,  28756,  28773,
+     28789,  28806,  28822,  28838,  28855,  28871,  28887,  28903,  28920,  28936,  28952,  28968,
+     28984,  29000,  29016,  29032,  29048,  29064,  29080,  29096,  29112,  29127,  29143,  29159,
+     29175,  29190,  29206,  29222,  29237,  29253,  29268,  29284,  29299,  29315,  29330,  29346,
+     29361,  29376,  29392,  29407,  29422,  29437,  29452,  29468,  29483,  29498,  29513,  29528,
+     29543,  29558,  29573,  29588,  29602,  29617,  29632,  29647,  29662,  29676,  29691,  29706,
+     29720,  29735,  29749,  29764,  29778,  29793,  29807,  29822,  29836,  29850,  29865,  29879,
+     29893,  29907,  29922,  29936,  29950,  29964,  29978,  29992,  30006,  30020,  30034,  30048,
+     30061,  30075,  30089,  30103,  30117,  30130,  30144,  30158,  30171,  30185,  30198,  30212,
+     30225,  30239,  30252,  30265,  30279,  30292,  30305,  30318,  30332,  30345,  30358,  30371,
+     30384,  30397,  30410,  30423,  30436,  30449,  30462,  30475,  30488,  30500,  30513,  30526,
+     30538,  30551,  30564,  30576,  30589,  30601,  30614,  30626,  30639,  30651,  30663,  30676,
+     30688,  30700,  30712,  30724,  30737,  30749,  30761,  30773,  30785,  30797,  30809,  30821,
+     30832,  30844,  30856,  30868,  30880,  30891,  30903,  30915,  30926,  30938,  30949,  30961,
+     30972,  30984,  30995,  31006,  31018,  31029,  31040,  31051,  31063,  31074,  31085,  31096,
+     31107,  31118,  31129,  31140,  31151,  31162,  31172,  31183,  31194,  31205,  31215,  31226,
+     31237,  31247,  31258,  31268,  31279,  31289,  31300,  31310,  31320,  31331,  31341,  31351,
+     31361,  31372,  31382,  31392,  31402,  31412,  31422,  31432,  31442,  31452,  31462,  31471,
+     31481,  31491,  31501,  31510,  31520,  31529,  31539,  31549,  31558,  31568,  31577,  31586,
+     31596,  31605,  31614,  31624,  31633,  31642,  31651,  31660,  31669,  31678,  31687,  31696,
+     31705,  31714,  31723,  31732,  31740,  31749,  31758,  31767,  31775,  31784,  31792,  31801,
+     31809,  31818,  31826,  31835,  31843,  31851,  31859,  31868,  31876,  31884,  31892,  31900,
+     31908,  31916,  31924,  31932,  31940,  31948,  31956,  31964,  31971,  31979,  31987,  31994,
+     32002,  32010,  32017,  32025,  32032,  32039,  32047,  32054,  32062,  32069,  32076,  32083,
+     32090,  32098,  32105,  32112,  32119,  32126,  32133,  32140,  32146,  32153,  32160,  32167,
+     32174,  32180,  32187,  32193,  32200,  32207,  32213,  32220,  32226,  32232,  32239,  32245,
+     32251,  32258,  32264,  32270,  32276,  32282,  32288,  32294,  32300,  32306,  32312,  32318,
+     32324,  32329,  32335,  32341,  32347,  32352,  32358,  32363,  32369,  32374,  32380,  32385,
+     32391,  32396,  32401,  32407,  32412,  32417,  32422,  32427,  32432,  32437,  32442,  32447,
+     32452,  32457,  32462,  32467,  32472,  32476,  32481,  32486,  32490,  32495,  32499,  32504,
+     32508,  32513,  32517,  32521,  32526,  32530,  32534,  32539,  32543,  32547,  32551,  32555,
+     32559,  32563,  32567,  32571,  32575,  32578,  32582,  32586,  32590,  32593,  32597,  32601,
+     32604,  32608,  32611,  32615,  32618,  32621,  32625,  32628,  32631,  32634,  32638,  32641,
+     32644,  32647,  32650,  32653,  32656,  32659,  32662,  32664,  32667,  32670,  32673,  32675,
+     32678,  32681,  32683,  32686,  32688,  32691,  32693,  32695,  32698,  32700,  32702,  32704,
+     32707,  32709,  32711,  32713,  32715,  32717,  32719,  32721,  32723,  32724,  32726,  32728,
+     32730,  32731,  32733,  32735,  32736,  32738,  32739,  32741,  32742,  32743,  32745,  32746,
+     32747,  32748,  32750,  32751,  32752,  32753,  32754,  32755,  32756,  32757,  32758,  32759,
+     32759,  32760,  32761,  32761,  32762,  32763,  32763,  32764,  32764,  32765,  32765,  32765,
+     32766,  32766,  32766,  32767,  32767,  32767,  32767,  32767,  32767,
+};
+
+/* Hamming: a0=0.54, a1=0.46 */
+static const q15_t s_WinHamming[WIN_TABLE_LEN / 2 + 1] = {
+      2621,   2621,   2621,   2622,   2622,   2622,   2622,   2622,   2622,   2623,   2623,   2624,
+      2624,   2624,   2625,   2625,   2626,   2626,   2627,   2628,   2628,   2629,   2630,   2631,
+      2632,   2632,   2633,   2634,   2635,   2636,   2637,   2638,   2640,   2641,   2642,   2643,
+      2644,   2646,   2647,   2648,   2650,   2651,   2653,   2654,   2656,   2657,   2659,   2661,
+      2662,   2664,   2666,   2667,   2669,   2671,   2673,   2675,   2677,   2679,   2681,   2683,
+      2685,   2687,   2689,   2692,   2694,   2696,   2699,   2701,   2703,   2706,   2708,   2711,
+      2713,   2716,   2718,   2721,   2724,   2726,   2729,   2732,   2735,   2738,   2740,   2743,
+      2746,   2749,   2752,   2755,   2758,   2762,   2765,   2768,   2771,   2774,   2778,   2781,
+      2785,   2788,   2791,   2795,   2798,   2802,   2805,   2809,   2813,   2816,   2820,   2824,
+      2828,   2832,   2835,   2839,   2843,   2847,   2851,   2855,   2859,   2863,   2868,   2872,
+      2876,   2880,   2885,   2889,   2893,   2898,   2902,   2906,   2911,   2916,   2920,   2925,
+      2929,   2934,   2939,   2943,   2948,   2953,   2958,   2963,   2968,   2973,   2978,   2983,
+      2988,   2993,   2998,   3003,   3008,   3013,   3019,   3024,   3029,   3035,   3040,   3045,
+      3051,   3056,   3062,   3067,   3073,   3079,   3084,   3090,   3096,   3102,   3107,   3113,
+      3119,   3125,   3131,   3137,   3143,   3149,   3155,   3161,   3167,   3174,   3180,   3186,
+      3192,   3199,   3205,   3211,   3218,   3224,   3231,   3237,   3244,   3250,   3257,   3264,
+      3270,   3277,   3284,   3291,   3298,   3304,   3311,   3318,   3325,   3332,   3339,   3346,
+      3353,   3361,   3368,   3375,   3382,   3389,   3397,   3404,   3411,   3419,   3426,   3434,
+      3441,   3449,   3456,   3464,   3472,   3479,   3487,   3495,   3502,   3510,   3518,   3526,
+      3534,   3542,   3550,   3558,   3566,   3574,   3582,   3590,   3598,   3607,   3615,   3623,
+      3631,   3640,   3648,   3656,   3665,   3673,   3682,   3690,   3699,   3708,   3716,   3725,
+      3734,   3742,   3751,   3760,   3769,   3778,   3786,   3795,   3804,   3813,   3822,   3831,
+      3841,   3850,   3859,   3868,   3877,   3886,   3896,   3905,   3914,   3924,   3933,   3943,
+      3952,   3962,   3971,   3981,   3990,   4000,   4010,   4019,   4029,   4039,   4049,   4059,
+      4069,   4078,   4088,   4098,   4108,   4118,   4128,   4138,   4149,   4159,   4169,   4179,
+      4189,   4200,   4210,   4220,   4231,   4241,   4252,   4262,   4273,   4283,   4294,   4304,
+      4315,   4326,   4336,   4347,   4358,   4369,   4379,   4390,   4401,   4412,   4423,   4434,
+      4445,   4456,   4467,   4478,   4489,   4500,   4512,   4523,   4534,   4545,   4557,   4568,
+      4580,   4591,   4602,   4614,   4625,   4637,   4648,   4660,   4672,   4683,   4695,   4707,
+      4718,   4730,   4742,   4754,   4766,   4778,   4790,   4802,   4814,   4826,   4838,   4850,
+      4862,   4874,   4886,   4898,   4911,   4923,   4935,   4947,   4960,   4972,   4985,   4997,
+      5010,   5022,   5035,   5047,   5060,   5072,   5085,   5098,   5110,   5123,   5136,   5149,
+      5162,   5174,   5187,   5200,   5213,   5226,   5239,   5252,   5265,   5278,   5292,   5305,
+      5318,   5331,   5344,   5358,   5371,   5384,   5398,   5411,   5424,   5438,   5451,   5465,
+      5478,   5492,   5505,   5519,   5533,   5546,   5560,   5574,   5588,   5601,   5615,   5629,
+      5643,   5657,   5671,   5685,   5699,   5713,   5727,   5741,   5755,   5769,   5783,   5797,
+      5812,   5826,   5840,   5854,   5869,   5883,   5897,   5912,   5926,   5941,   5955,   5970,
+      5984,   5999,   6013,   6028,   6043,   6057,   6072,   6087,   6102,   6116,   6131,   6146,
+      6161,   6176,   6191,   6206,   6221,   6236,   6251,   6266,   6281,   6296,   6311,   6326,
+      6342,   6357,   6372,   6387,   6403,   6418,   6433,   6449,   6464,   6479,   6495,   6510,
+      6526,   6541,   6557,   6573,   6588,   6604,   6620,   6635,   6651,   6667,   6683,   6698,
+      6714,   6730,   6746,   6762,   6778,   6794,   6810,   6826,   6842,   6858,   6874,   6890,
+      6906,   6922,   6938,   6955,   6971,   6987,   7003,   7020,   7036,   7052,   7069,   7085,
+      7102,   7118,   7135,   7151,   7168,   7184,   7201,   7217,   7234,   7251,   7267,   7284,
+      7301,   7318,   7334,   7351,   7368,   7385,   7402,   7419,   7436,   7453,   7470,   7487,
+      7504,   7521,   7538,   7555,   7572,   7589,   7606,   7623,   7641,   7658,   7675,   7692,
+      7710,   7727,   7744,   7762,   7779,   7797,   7814,   7832,   7849,   7867,   7884,   7902,
+      7919,   7937,   7954,   7972,   7990,   8008,   8025,   8043,   8061,   8079,   8096,   8114,
+      8132,   8150,   8168,   8186,   8204,   8222,   8240,   8258,   8276,   8294,   8312,   8330,
+      8348,   8366,   8384,   8403,   8421,   8439,   8457,   8476,   8494,   8512,   8531,   8549,
+      8567,   8586,   8604,   8623,   8641,   8660,   8678,   8697,   8715,   8734,   8752,   8771,
+      8790,   8808,   8827,   8846,   8865,   8883,   8902,   8921,   8940,   8959,   8977,   8996,
+      9015,   9034,   9053,   9072,   9091,   9110,   9129,   9148,   9167,   9186,   9205,   9224,
+      9243,   9263,   9282,   9301,   9320,   9339,   9359,   9378,   9397,   9417,   9436,   9455,
+      9475,   9494,   9513,   9533,   9552,   9572,   9591,   9611,   9630,   9650,   9669,   9689,
+      9709,   9728,   9748,   9767,   9787,   9807,   9827,   9846,   9866,   9886,   9906,   9925,
+      9945,   9965,   9985,  10005,  10025,  10045,  10065,  10084,  10104,  10124,  10144,  10164,
+     10184,  10205,  10225,  10245,  10265,  10285,  10305,  10325,  10345,  10366,  10386,  10406,
+     10426,  10447,  10467,  10487,  10507,  10528,  10548,  10569,  10589,  10609,  10630,  10650,
+     10671,  10691,  10712,  10732,  10753,  10773,  10794,  10814,  10835,  10855,  10876,  10897,
+     10917,  10938,  10959,  10979,  11000,  11021,  11041,  11062,  11083,  11104,  11125,  11145,
+     11166,  11187,  11208,  11229,  11250,  11271,  11292,  11312,  11333,  11354,  11375,  11396,
+     11417,  11438,  11459,  11481,  11502,  11523,  11544,  11565,  11586,  11607,  11628,  11650,
+     11671,  11692,  11713,  11734,  11756,  11777,  11798,  11819,  11841,  11862,  11883,  11905,
+     11926,  11947,  11969,  11990,  12012,  12033,  12054,  12076,  12097,  12119,  12140,  12162,
+     12183,  12205,  12226,  12248,  12270,  12291,  12313,  12334,  12356,  12378,  12399,  12421,
+     12443,  12464,  12486,  12508,  12529,  12551,  12573,  12595,  12616,  12638,  12660,  12682,
+     12703,  12725,  12747,  12769,  12791,  12813,  12835,  12856,  12878,  12900,  12922,  12944,
+     12966,  12988,  13010,  13032,  13054,  13076,  13098,  13120,  13142,  13164,  13186,  13208,
+     13230,  13252,  13275,  13297,  13319,  13341,  13363,  13385,  13407,  13430,  13452,  13474,
+     13496,  13518,  13541,  13563,  13585,  13607,  13630,  13652,  13674,  13696,  13719,  13741,
+     13763,  13786,  13808,  13830,  13853,  13875,  13897,  13920,  13942,  13965,  13987,  14009,
+     14032,  14054,  14077,  14099,  14122,  14144,  14167,  14189,  14211,  14234,  14256,  14279,
+     14302,  14324,  14347,  14369,  14392,  14414,  14437,  14459,  14482,  14505,  14527,  14550,
+     14572,  14595,  14618,  14640,  14663,  14686,  14708,  14731,  14754,  14776,  14799,  14822,
+     14844,  14867,  14890,  14913,  14935,  14958,  14981,  15003,  15026,  15049,  15072,  15095,
+     15117,  15140,  15163,  15186,  15208,  15231,  15254,  15277,  15300,  15323,  15345,  15368,
+     15391,  15414,  15437,  15460,  15483,  15505,  15528,  15551,  15574,  15597,  15620,  15643,
+     15666,  15689,  15712,  15734,  15757,  15780,  15803,  15826,  15849,  15872,  15895,  15918,
+     15941,  15964,  15987,  16010,  16033,  16056,  16079,  16102,  16125,  16148,  16171,  16194,
+     16217,  16240,  16263,  16286,  16309,  16332,  16355,  16378,  16401,  16424,  16447,  16470,
+     16493,  16516,  16539,  16562,  16585,  16608,  16631,  16655,  16678,  16701,  16724,  16747,
+     16770,  16793,  16816,  16839,  16862,  16885,  16908,  16931,  16955,  16978,  17001,  17024,
+     17047,  17070,  17093,  17116,  17139,  17162,  17186,  17209,  17232,  17255,  17278,  17301,
+     17324,  17347,  17371,  17394,  17417,  17440,  17463,  17486,  17509,  17532,  17555,  17579,
+     17602,  17625,  17648,  17671,  17694,  17717,  17740,  17764,  17787,  17810,  17833,  17856,
+     17879,  17902,  17925,  17949,  17972,  17995,  18018,  18041,  18064,  18087,  18110,  18133,
+     18157,  18180,  18203,  18226,  18249,  18272,  18295,  18318,  18341,  18364,  18388,  18411,
+     18434,  18457,  18480,  18503,  18526,  18549,  18572,  18595,  18618,  18642,  18665,  18688,
+     18711,  18734,  18757,  18780,  18803,  18826,  18849,  18872,  18895,  18918,  18941,  18964,
+     18987,  19010,  19033,  19056,  19080,  19103,  19126,  19149,  19172,  19195,  19218,  19241,
+     19264,  19287,  19310,  19333,  19356,  19379,  19401,  19424,  19447,  19470,  19493,  19516,
+     19539,  19562,  19585,  19608,  19631,  19654,  19677,  19700,  19723,  19746,  19769,  19791,
+     19814,  19837,  19860,  19883,  19906,  19929,  19952,  19974,  19997,  20020,  20043,  20066,
+     20089,  20111,  20134,  20157,  20180,  20203,  20225,  20248,  20271,  20294,  20317,  20339,
+     20362,  20385,  20408,  20430,  20453,  20476,  20499,  20521,  20544,  20567,  20589,  20612,
+     20635,  20657,  20680,  20703,  20725,  20748,  20771,  20793,  20816,  20839,  20861,  20884,
+     20906,  20929,  20952,  20974,  20997,  21019,  21042,  21064,  21087,  21109,  21132,  21154,
+     21177,  21199,  21222,  21244,  21267,  21289,  21312,  21334,  21357,  21379,  21401,  21424,
+     21446,  21469,  21491,  21513,  21536,  21558,  21580,  21603,  21625,  21647,  21670,  21692,
+     21714,  21737,  21759,  21781,  21803,  21826,  21848,  21870,  21892,  21914,  21937,  21959,
+     21981,  22003,  22025,  22047,  22070,  22092,  22114,  22136,  22158,  22180,  22202,  22224,
+     22246,  22268,  22290,  22312,  22334,  22356,  22378,  22400,  22422,  22444,  22466,  22488,
+     22510,  22532,  22554,  22576,  22598,  22619,  22641,  22663,  22685,  22707,  22728,  22750,
+     22772,  22794,  22816,  22837,  22859,  22881,  22902,  22924,  22946,  22967,  22989,  23011,
+     23032,  23054,  23076,  23097,  23119,  23140,  23162,  23183,  23205,  23227,  23248,  23270,
+     23291,  23312,  23334,  23355,  23377,  23398,  23420,  23441,  23462,  23484,  23505,  23526,
+     23548,  23569,  23590,  23611,  23633,  23654,  23675,  23696,  23718,  23739,  23760,  23781,
+     23802,  23823,  23845,  23866,  23887,  23908,  23929,  23950,  23971,  23992,  24013,  24034,
+     24055,  24076,  24097,  24118,  24139,  24160,  24180,  24201,  24222,  24243,  24264,  24285,
+     24305,  24326,  24347,  24368,  24388,  24409,  24430,  24450,  24471,  24492,  24512,  24533,
+     24554,  24574,  24595,  24615,  24636,  24656,  24677,  24697,  24718,  24738,  24759,  24779,
+     24799,  24820,  24840,  24861,  24881,  24901,  24922,  24942,  24962,  24982,  25003,  25023,
+     25043,  25063,  25083,  25103,  25124,  25144,  25164,  25184,  25204,  25224,  25244,  25264,
+     25284,  25304,  25324,  25344,  25364,  25384,  25403,  25423,  25443,  25463,  25483,  25503,
+     25522,  25542,  25562,  25582,  25601,  25621,  25641,  25660,  25680,  25699,  25719,  25739,
+     25758,  25778,  25797,  25817,  25836,  25856,  25875,  25894,  25914,  25933,  25952,  25972,
+     25991,  26010,  26030,  26049,  26068,  26087,  26107,  26126,  26145,  26164,  26183,  26202,
+     26221,  26240,  26259,  26278,  26297,  26316,  26335,  26354,  26373,  26392,  26411,  26430,
+     26449,  26467,  26486,  26505,  26524,  26543,  26561,  26580,  26599,  26617,  26636,  26654,
+     26673,  26692,  26710,  26729,  26747,  26766,  26784,  26803,  26821,  26839,  26858,  26876,
+     26894,  26913,  26931,  26949,  26967,  26986,  27004,  27022,  27040,  27058,  27076,  27095,
+     27113,  27131,  27149,  27167,  27185,  27203,  27220,  27238,  27256,  27274,  27292,  27310,
+     27328,  27345,  27363,  27381,  27399,  27416,  27434,  27452,  27469,  27487,  27504,  27522,
+     27539,  27557,  27574,  27592,  27609,  27627,  27644,  27661,  27679,  27696,  27713,  27731,
+     27748,  27765,  27782,  27799,  27816,  27834,  27851,  27868,  27885,  27902,  27919,  27936,
+     27953,  27970,  27987,  28003,  28020,  28037,  28054,  28071,  28088,  28104,  28121,  28138,
+     28154,  28171,  28188,  28204,  28221,  28237,  28254,  28270,  28287,  28303,  28320,  28336,
+     28352,  28369,  28385,  28401,  28417,  28434,  28450,  28466,  28482,  28498,  28515,  28531,
+     28547,  28563,  28579,  28595,  28611,  28627,  28642,  28658,  28674,  28690,  28706,  28722,
+     28737,  28753,  28769,  28784,  28800,  28816,  28831,  28847,  28862,  28878,  28893,  28909,
+     28924,  28940,  28955,  28970,  28986,  29001,  29016,  29032,  29047,  29062,  29077,  29092,
+     29107,  29123,  29138,  29153,  29168,  29183,  29198,  29213,  29227,  29242,  29257,  29272,
+     29287,  29301,  29316,  29331,  29346,  29360,  29375,  29390,  29404,  29419,  29433,  29448,
+     29462,  29477,  29491,  29505,  29520,  29534,  29548,  29563,  29577,  29591,  29605,  29619,
+     29633,  29648,  29662,  29676,  29690,  29704,  29718,  29732,  29745,  29759,  29773,  29787,
+     29801,  29815,  29828,  29842,  29856,  29869,  29883,  29896,  29910,  29924,  29937,  29951,
+     29964,  29977,  29991,  30004,  30017,  30031,  30044,  30057,  30071,  30084,  30097,  30110,
+     30123,  30136,  30149,  30162,  30175,  30188,  30201,  30214,  30227,  30240,  30252,  30265,
+     30278,  30291,  30303,  30316,  30329,  30341,  30354,  30366,  30379,  30391,  30404,  30416,
+     30429,  30441,  30453,  30465,  30478,  30490,  30502,  30514,  30527,  30539,  30551,  30563,
+     30575,  30587,  30599,  30611,  30623,  30634,  30646,  30658,  30670,  30682,  30693,  30705,
+     30717,  30728,  30740,  30751,  30763,  30775,  30786,  30797,  30809,  30820,  30832,  30843,
+     30854,  30865,  30877,  30888,  30899,  30910,  30921,  30932,  30943,  30954,  30965,  30976,
+     30987,  30998,  31009,  31020,  31031,  31041,  31052,  31063,  31073,  31084,  31095,  31105,
+     31116,  31126,  31137,  31147,  31158,  31168,  31178,  31189,  31199,  31209,  31219,  31230,
+     31240,  31250,  31260,  31270,  31280,  31290,  31300,  31310,  31320,  31330,  31340,  31349,
+     31359,  31369,  31379,  31388,  31398,  31408,  31417,  31427,  31436,  31446,  31455,  31465,
+     31474,  31483,  31493,  31502,  31511,  31520,  31530,  31539,  31548,  31557,  31566,  31575,
+     31584,  31593,  31602,  31611,  31620,  31628,  31637,  31646,  31655,  31663,  31672,  31681,
+     31689,  31698,  31706,  31715,  31723,  31732,  31740,  31749,  31757,  31765,  31774,  31782,
+     31790,  31798,  31806,  31814,  31823,  31831,  31839,  31847,  31854,  31862,  31870,  31878,
+     31886,  31894,  31901,  31909,  31917,  31924,  31932,  31940,  31947,  31955,  31962,  31970,
+     31977,  31984,  31992,  31999,  32006,  32013,  32021,  32028,  32035,  32042,  32049,  32056,
+     32063,  32070,  32077,  32084,  32091,  32098,  32104,  32111,  32118,  32125,  32131,  32138,
+     32145,  32151,  32158,  32164,  32171,  32177,  32183,  32190,  32196,  32202,  32209,  32215,
+     32221,  32227,  32233,  32239,  32245,  32251,  32257,  32263,  32269,  32275,  32281,  32287,
+     32293,  32298,  32304,  32310,  32315,  32321,  32326,  32332,  32337,  32343,  32348,  32354,
+     32359,  32364,  32370,  32375,  32380,  32385,  32391,  32396,  32401,  32406,  32411,  32416,
+     32421,  32426,  32431,  32435,  32440,  32445,  32450,  32454,  32459,  32464,  32468,  32473,
+     32477,  32482,  32486,  32491,  32495,  32499,  32504,  32508,  32512,  32517,  32521,  32525,
+     32529,  32533,  32537,  32541,  32545,  32549,  32553,  32557,  32561,  32564,  32568,  32572,
+     32576,  32579,  32583,  32586,  32590,  32594,  32597,  32600,  32604,  32607,  32611,  32614,
+     32617,  32620,  32624,  32627,  32630,  32633,  32636,  32639,  32642,  32645,  32648,  32651,
+     32654,  32656,  32659,  32662,  32665,  32667,  32670,  32673,  32675,  32678,  32680,  32683,
+     32685,  32687,  32690,  32692,  32694,  32697,  32699,  32701,  32703,  32705,  32707,  32709,
+     32711,  32713,  32715,  32717,  32719,  32721,  32723,  32724,  32726,  32728,  32729,  32731,
+     32733,  32734,  32736,  32737,  32739,  32740,  32741,  32743,  32744,  32745,  32747,  32748,
+     32749,  32750,  32751,  32752,  32753,  32754,  32755,  32756,  32757,  32758,  32758,  32759,
+     32760,  32761,  32761,  32762,  32762,  32763,  32764,  32764,  32764,  32765,  32765,  32766,
+     32766,  32766,  32766,  32767,  32767,  32767,  32767,  32767,  32767,
+};
+
+/* Flat-top (MATLAB flattopwin): a0=0.21557895, a1=0.41663158, a2=0.277263158, a3=0.083578947, a4=0.006947368 */
+static const q15_t s_WinFlatTop[WIN_TABLE_LEN / 2 + 1] = {
+       -14,    -14,    -14,    -14,    -14,    -14,    -14,    -14,    -14,    -14,    -14,    -14,
+       -14,    -14,    -14,    -14,    -14,    -14,    -14,    -15,    -15,    -15,    -15,    -15,
+       -15,    -15,    -15,    -15,    -15,    -15,    -16,    -16,    -16,    -16,    -16,    -16,
+       -16,    -17,    -17,    -17,    -17,    -17,    -17,    -17,    -18,    -18,    -18,    -18,
+       -18,    -19,    -19,    -19,    -19,    -19,    -20,    -20,    -20,    -20,    -21,    -21,
+       -21,    -21,    -22,    -22,    -22,    -22,    -23,    -23,    -23,    -23,    -24,    -24,
+       -24,    -25,    -25,    -25,    -25,    -26,    -26,    -26,    -27,    -27,    -27,    -28,
+       -28,    -28,    -29,    -29,    -30,    -30,    -30,    -31,    -31,    -31,    -32,    -32,
+       -33,    -33,    -33,    -34,    -34,    -35,    -35,    -36,    -36,    -37,    -37,    -37,
+       -38,    -38,    -39,    -39,    -40,    -40,    -41,    -41,    -42,    -42,    -43,    -43,
+       -44,    -44,    -45,    -45,    -46,    -46,    -47,    -48,    -48,    -49,    -49,    -50,
+       -50,    -51,    -52,    -52,    -53,    -53,    -54,    -55,    -55,    -56,    -57,    -57,
+       -58,    -59,    -59,    -60,    -61,    -61,    -62,    -63,    -63,    -64,    -65,    -65,
+       -66,    -67,    -68,    -68,    -69,    -70,    -71,    -71,    -72,    -73,    -74,    -75,
+       -75,    -76,    -77,    -78,    -79,    -79,    -80,    -81,    -82,    -83,    -84,    -84,
+       -85,    -86,    -87,    -88,    -89,    -90,    -91,    -92,    -93,    -94,    -94,    -95,
+       -96,    -97,    -98,    -99,   -100,   -101,   -102,   -103,   -104,   -105,   -106,   -107,
+      -108,   -109,   -110,   -111,   -113,   -114,   -115,   -116,   -117,   -118,   -119,   -120,
+      -121,   -122,   -124,   -125,   -126,   -127,   -128,   -129,   -131,   -132,   -133,   -134,
+      -135,   -137,   -138,   -139,   -140,   -142,   -143,   -144,   -145,   -147,   -148,   -149,
+      -151,   -152,   -153,   -155,   -156,   -157,   -159,   -160,   -161,   -163,   -164,   -165,
+      -167,   -168,   -170,   -171,   -173,   -174,   -176,   -177,   -178,   -180,   -181,   -183,
+      -184,   -186,   -188,   -189,   -191,   -192,   -194,   -195,   -197,   -199,   -200,   -202,
+      -203,   -205,   -207,   -208,   -210,   -212,   -213,   -215,   -217,   -218,   -220,   -222,
+      -224,   -225,   -227,   -229,   -231,   -232,   -234,   -236,   -238,   -240,   -241,   -243,
+      -245,   -247,   -249,   -251,   -253,   -254,   -256,   -258,   -260,   -262,   -264,   -266,
+      -268,   -270,   -272,   -274,   -276,   -278,   -280,   -282,   -284,   -286,   -288,   -290,
+      -292,   -294,   -297,   -299,   -301,   -303,   -305,   -307,   -309,   -312,   -314,   -316,
+      -318,   -320,   -323,   -325,   -327,   -329,   -332,   -334,   -336,   -339,   -341,   -343,
+      -346,   -348,   -350,   -353,   -355,   -357,   -360,   -362,   -365,   -367,   -370,   -372,
+      -375,   -377,   -379,   -382,   -385,   -387,   -390,   -392,   -395,   -397,   -400,   -402,
+      -405,   -408,   -410,   -413,   -416,   -418,   -421,   -424,   -426,   -429,   -432,   -434,
+      -437,   -440,   -443,   -445,   -448,   -451,   -454,   -457,   -459,   -462,   -465,   -468,
+      -471,   -474,   -477,   -480,   -482,   -485,   -488,   -491,   -494,   -497,   -500,   -503,
+      -506,   -509,   -512,   -515,   -518,   -521,   -525,   -528,   -531,   -534,   -537,   -540,
+      -543,   -546,   -550,   -553,   -556,   -559,   -562,   -566,   -569,   -572,   -575,   -579,
+      -582,   -585,   -589,   -592,   -595,   -599,   -602,   -605,   -609,   -612,   -615,   -619,
+      -622,   -626,   -629,   -633,   -636,   -639,   -643,   -646,   -650,   -654,   -657,   -661,
+      -664,   -668,   -671,   -675,   -678,   -682,   -686,   -689,   -693,   -697,   -700,   -704,
+      -708,   -711,   -715,   -719,   -723,   -726,   -730,   -734,   -738,   -741,   -745,   -749,
+      -753,   -757,   -760,   -764,   -768,   -772,   -776,   -780,   -784,   -788,   -792,   -796,
+      -799,   -803,   -807,   -811,   -815,   -819,   -823,   -827,   -831,   -835,   -839,   -844,
+      -848,   -852,   -856,   -860,   -864,   -868,   -872,   -876,   -881,   -885,   -889,   -893,
+      -897,   -901,   -906,   -910,   -914,   -918,   -923,   -927,   -931,   -935,   -940,   -944,
+      -948,   -952,   -957,   -961,   -965,   -970,   -974,   -979,   -983,   -987,   -992,   -996,
+     -1000,  -1005,  -1009,  -1014,  -1018,  -1023,  -1027,  -1032,  -1036,  -1040,  -1045,  -1049,
+     -1054,  -1058,  -1063,  -1068,  -1072,  -1077,  -1081,  -1086,  -1090,  -1095,  -1099,  -1104,
+     -1109,  -1113,  -1118,  -1122,  -1127,  -1132,  -1136,  -1141,  -1146,  -1150,  -1155,  -1160,
+     -1164,  -1169,  -1174,  -1178,  -1183,  -1188,  -1192,  -1197,  -1202,  -1206,  -1211,  -1216,
+     -1221,  -1225,  -1230,  -1235,  -1240,  -1244,  -1249,  -1254,  -1259,  -1264,  -1268,  -1273,
+     -1278,  -1283,  -1288,  -1292,  -1297,  -1302,  -1307,  -1312,  -1316,  -1321,  -1326,  -1331,
+     -1336,  -1341,  -1346,  -1350,  -1355,  -1360,  -1365,  -1370,  -1375,  -1380,  -1384,  -1389,
+     -1394,  -1399,  -1404,  -1409,  -1414,  -1419,  -1423,  -1428,  -1433,  -1438,  -1443,  -1448,
+     -1453,  -1458,  -1463,  -1467,  -1472,  -1477,  -1482,  -1487,  -1492,  -1497,  -1502,  -1507,
+     -1511,  -1516,  -1521,  -1526,  -1531,  -1536,  -1541,  -1546,  -1551,  -1555,  -1560,  -1565,
+     -1570,  -1575,  -1580,  -1585,  -1590,  -1594,  -1599,  -1604,  -1609,  -1614,  -1619,  -1624,
+     -1628,  -1633,  -1638,  -1643,  -1648,  -1653,  -1657,  -1662,  -1667,  -1672,  -1677,  -1681,
+     -1686,  -1691,  -1696,  -1700,  -1705,  -1710,  -1715,  -1719,  -1724,  -1729,  -1734,  -1738,
+     -1743,  -1748,  -1753,  -1757,  -1762,  -1767,  -1771,  -1776,  -1781,  -1785,  -1790,  -1795,
+     -1799,  -1804,  -1808,  -1813,  -1818,  -1822,  -1827,  -1831,  -1836,  -1840,  -1845,  -1849,
+     -1854,  -1858,  -1863,  -1867,  -1872,  -1876,  -1881,  -1885,  -1890,  -1894,  -1898,  -1903,
+     -1907,  -1911,  -1916,  -1920,  -1924,  -1929,  -1933,  -1937,  -1941,  -1946,  -1950,  -1954,
+     -1958,  -1963,  -1967,  -1971,  -1975,  -1979,  -1983,  -1987,  -1991,  -1996,  -2000,  -2004,
+     -2008,  -2012,  -2016,  -2020,  -2023,  -2027,  -2031,  -2035,  -2039,  -2043,  -2047,  -2051,
+     -2054,  -2058,  -2062,  -2066,  -2069,  -2073,  -2077,  -2080,  -2084,  -2088,  -2091,  -2095,
+     -2098,  -2102,  -2105,  -2109,  -2112,  -2116,  -2119,  -2123,  -2126,  -2129,  -2133,  -2136,
+     -2139,  -2143,  -2146,  -2149,  -2152,  -2155,  -2159,  -2162,  -2165,  -2168,  -2171,  -2174,
+     -2177,  -2180,  -2183,  -2186,  -2188,  -2191,  -2194,  -2197,  -2200,  -2202,  -2205,  -2208,
+     -2210,  -2213,  -2216,  -2218,  -2221,  -2223,  -2226,  -2228,  -2231,  -2233,  -2235,  -2238,
+     -2240,  -2242,  -2245,  -2247,  -2249,  -2251,  -2253,  -2255,  -2257,  -2259,  -2261,  -2263,
+     -2265,  -2267,  -2269,  -2271,  -2272,  -2274,  -2276,  -2277,  -2279,  -2281,  -2282,  -2284,
+     -2285,  -2287,  -2288,  -2289,  -2291,  -2292,  -2293,  -2294,  -2296,  -2297,  -2298,  -2299,
+     -2300,  -2301,  -2302,  -2303,  -2304,  -2304,  -2305,  -2306,  -2307,  -2307,  -2308,  -2309,
+     -2309,  -2310,  -2310,  -2310,  -2311,  -2311,  -2311,  -2312,  -2312,  -2312,  -2312,  -2312,
+     -2312,  -2312,  -2312,  -2312,  -2312,  -2311,  -2311,  -2311,  -2311,  -2310,  -2310,  -2309,
+     -2309,  -2308,  -2307,  -2307,  -2306,  -2305,  -2304,  -2303,  -2302,  -2301,  -2300,  -2299,
+     -2298,  -2297,  -2296,  -2295,  -2293,  -2292,  -2290,  -2289,  -2287,  -2286,  -2284,  -2282,
+     -2281,  -2279,  -2277,  -2275,  -2273,  -2271,  -2269,  -2267,  -2264,  -2262,  -2260,  -2258,
+     -2255,  -2253,  -2250,  -2248,  -2245,  -2242,  -2239,  -2237,  -2234,  -2231,  -2228,  -2225,
+     -2222,  -2218,  -2215,  -2212,  -2208,  -2205,  -2202,  -2198,  -2194,  -2191,  -2187,  -2183,
+     -2179,  -2176,  -2172,  -2168,  -2163,  -2159,  -2155,  -2151,  -2146,  -2142,  -2138,  -2133,
+     -2128,  -2124,  -2119,  -2114,  -2109,  -2104,  -2099,  -2094,  -2089,  -2084,  -2079,  -2073,
+     -2068,  -2062,  -2057,  -2051,  -2046,  -2040,  -2034,  -2028,  -2022,  -2016,  -2010,  -2004,
+     -1998,  -1991,  -1985,  -1979,  -1972,  -1965,  -1959,  -1952,  -1945,  -1938,  -1931,  -1924,
+     -1917,  -1910,  -1903,  -1896,  -1888,  -1881,  -1873,  -1866,  -1858,  -1850,  -1842,  -1834,
+     -1826,  -1818,  -1810,  -1802,  -1794,  -1785,  -1777,  -1768,  -1760,  -1751,  -1742,  -1733,
+     -1724,  -1715,  -1706,  -1697,  -1688,  -1679,  -1669,  -1660,  -1650,  -1641,  -1631,  -1621,
+     -1611,  -1601,  -1591,  -1581,  -1571,  -1560,  -1550,  -1540,  -1529,  -1519,  -1508,  -1497,
+     -1486,  -1475,  -1464,  -1453,  -1442,  -1431,  -1419,  -1408,  -1396,  -1385,  -1373,  -1361,
+     -1349,  -1337,  -1325,  -1313,  -1301,  -1288,  -1276,  -1264,  -1251,  -1238,  -1226,  -1213,
+     -1200,  -1187,  -1174,  -1160,  -1147,  -1134,  -1120,  -1107,  -1093,  -1079,  -1066,  -1052,
+     -1038,  -1024,  -1009,   -995,   -981,   -966,   -952,   -937,   -922,   -908,   -893,   -878,
+      -863,   -847,   -832,   -817,   -801,   -786,   -770,   -754,   -739,   -723,   -707,   -691,
+      -674,   -658,   -642,   -625,   -609,   -592,   -575,   -558,   -541,   -524,   -507,   -490,
+      -472,   -455,   -437,   -420,   -402,   -384,   -366,   -348,   -330,   -312,   -294,   -275,
+      -257,   -238,   -219,   -201,   -182,   -163,   -144,   -124,   -105,    -86,    -66,    -47,
+       -27,     -7,     13,     33,     53,     73,     93,    114,    134,    155,    176,    196,
+       217,    238,    259,    280,    302,    323,    345,    366,    388,    410,    432,    454,
+       476,    498,    520,    542,    565,    588,    610,    633,    656,    679,    702,    725,
+       749,    772,    796,    819,    843,    867,    891,    915,    939,    963,    987,   1012,
+      1036,   1061,   1086,   1111,   1135,   1161,   1186,   1211,   1236,   1262,   1287,   1313,
+      1339,   1365,   1391,   1417,   1443,   1469,   1496,   1522,   1549,   1575,   1602,   1629,
+      1656,   1683,   1710,   1738,   1765,   1793,   1820,   1848,   1876,   1904,   1932,   1960,
+      1988,   2017,   2045,   2074,   2102,   2131,   2160,   2189,   2218,   2247,   2277,   2306,
+      2336,   2365,   2395,   2425,   2455,   2485,   2515,   2545,   2575,   2606,   2636,   2667,
+      2698,   2728,   2759,   2790,   2822,   2853,   2884,   2916,   2947,   2979,   3011,   3042,
+      3074,   3107,   3139,   3171,   3203,   3236,   3268,   3301,   3334,   3367,   3400,   3433,
+      3466,   3499,   3533,   3566,   3600,   3634,   3667,   3701,   3735,   3769,   3804,   3838,
+      3872,   3907,   3941,   3976,   4011,   4046,   4081,   4116,   4151,   4186,   4222,   4257,
+      4293,   4329,   4364,   4400,   4436,   4472,   4509,   4545,   4581,   4618,   4654,   4691,
+      4728,   4765,   4802,   4839,   4876,   4913,   4950,   4988,   5025,   5063,   5101,   5139,
+      5177,   5215,   5253,   5291,   5329,   5368,   5406,   5445,   5484,   5522,   5561,   5600,
+      5639,   5678,   5718,   5757,   5797,   5836,   5876,   5915,   5955,   5995,   6035,   6075,
+      6115,   6156,   6196,   6236,   6277,   6318,   6358,   6399,   6440,   6481,   6522,   6563,
+      6605,   6646,   6687,   6729,   6770,   6812,   6854,   6896,   6938,   6980,   7022,   7064,
+      7106,   7149,   7191,   7234,   7277,   7319,   7362,   7405,   7448,   7491,   7534,   7577,
+      7621,   7664,   7708,   7751,   7795,   7838,   7882,   7926,   7970,   8014,   8058,   8103,
+      8147,   8191,   8236,   8280,   8325,   8369,   8414,   8459,   8504,   8549,   8594,   8639,
+      8684,   8730,   8775,   8820,   8866,   8911,   8957,   9003,   9049,   9094,   9140,   9186,
+      9233,   9279,   9325,   9371,   9418,   9464,   9511,   9557,   9604,   9651,   9697,   9744,
+      9791,   9838,   9885,   9932,   9980,  10027,  10074,  10122,  10169,  10216,  10264,  10312,
+     10359,  10407,  10455,  10503,  10551,  10599,  10647,  10695,  10743,  10792,  10840,  10888,
+     10937,  10985,  11034,  11083,  11131,  11180,  11229,  11278,  11326,  11375,  11424,  11474,
+     11523,  11572,  11621,  11670,  11720,  11769,  11818,  11868,  11918,  11967,  12017,  12066,
+     12116,  12166,  12216,  12266,  12316,  12366,  12416,  12466,  12516,  12566,  12616,  12666,
+     12717,  12767,  12817,  12868,  12918,  12969,  13019,  13070,  13121,  13171,  13222,  13273,
+     13324,  13374,  13425,  13476,  13527,  13578,  13629,  13680,  13731,  13782,  13834,  13885,
+     13936,  13987,  14038,  14090,  14141,  14193,  14244,  14295,  14347,  14398,  14450,  14501,
+     14553,  14605,  14656,  14708,  14760,  14811,  14863,  14915,  14967,  15018,  15070,  15122,
+     15174,  15226,  15278,  15330,  15382,  15434,  15486,  15538,  15590,  15642,  15694,  15746,
+     15798,  15850,  15902,  15954,  16006,  16058,  16111,  16163,  16215,  16267,  16319,  16372,
+     16424,  16476,  16528,  16581,  16633,  16685,  16737,  16790,  16842,  16894,  16947,  16999,
+     17051,  17103,  17156,  17208,  17260,  17313,  17365,  17417,  17470,  17522,  17574,  17627,
+     17679,  17731,  17783,  17836,  17888,  17940,  17992,  18045,  18097,  18149,  18201,  18254,
+     18306,  18358,  18410,  18462,  18515,  18567,  18619,  18671,  18723,  18775,  18827,  18879,
+     18931,  18983,  19035,  19087,  19139,  19191,  19243,  19295,  19347,  19399,  19451,  19503,
+     19554,  19606,  19658,  19710,  19761,  19813,  19865,  19916,  19968,  20020,  20071,  20123,
+     20174,  20225,  20277,  20328,  20380,  20431,  20482,  20533,  20585,  20636,  20687,  20738,
+     20789,  20840,  20891,  20942,  20993,  21044,  21095,  21146,  21196,  21247,  21298,  21348,
+     21399,  21449,  21500,  21550,  21601,  21651,  21702,  21752,  21802,  21852,  21902,  21952,
+     22002,  22052,  22102,  22152,  22202,  22252,  22301,  22351,  22401,  22450,  22500,  22549,
+     22598,  22648,  22697,  22746,  22795,  22844,  22893,  22942,  22991,  23040,  23089,  23137,
+     23186,  23235,  23283,  23332,  23380,  23428,  23476,  23525,  23573,  23621,  23669,  23717,
+     23764,  23812,  23860,  23907,  23955,  24002,  24050,  24097,  24144,  24191,  24238,  24285,
+     24332,  24379,  24426,  24473,  24519,  24566,  24612,  24659,  24705,  24751,  24797,  24843,
+     24889,  24935,  24981,  25026,  25072,  25118,  25163,  25208,  25254,  25299,  25344,  25389,
+     25434,  25478,  25523,  25568,  25612,  25657,  25701,  25745,  25789,  25834,  25877,  25921,
+     25965,  26009,  26052,  26096,  26139,  26182,  26226,  26269,  26312,  26354,  26397,  26440,
+     26482,  26525,  26567,  26609,  26652,  26694,  26735,  26777,  26819,  26861,  26902,  26943,
+     26985,  27026,  27067,  27108,  27149,  27189,  27230,  27270,  27311,  27351,  27391,  27431,
+     27471,  27511,  27551,  27590,  27630,  27669,  27708,  27747,  27786,  27825,  27864,  27902,
+     27941,  27979,  28017,  28055,  28093,  28131,  28169,  28207,  28244,  28282,  28319,  28356,
+     28393,  28430,  28466,  28503,  28539,  28576,  28612,  28648,  28684,  28720,  28756,  28791,
+     28826,  28862,  28897,  28932,  28967,  29002,  29036,  29071,  29105,  29139,  29173,  29207,
+     29241,  29275,  29308,  29342,  29375,  29408,  29441,  29474,  29506,  29539,  29571,  29603,
+     29636,  29667,  29699,  29731,  29762,  29794,  29825,  29856,  29887,  29918,  29949,  29979,
+     30009,  30040,  30070,  30100,  30129,  30159,  30188,  30218,  30247,  30276,  30305,  30333,
+     30362,  30390,  30418,  30447,  30475,  30502,  30530,  30557,  30585,  30612,  30639,  30666,
+     30692,  30719,  30745,  30771,  30798,  30823,  30849,  30875,  30900,  30925,  30951,  30975,
+     31000,  31025,  31049,  31074,  31098,  31122,  31146,  31169,  31193,  31216,  31239,  31262,
+     31285,  31308,  31330,  31352,  31375,  31397,  31418,  31440,  31462,  31483,  31504,  31525,
+     31546,  31567,  31587,  31607,  31627,  31647,  31667,  31687,  31706,  31726,  31745,  31764,
+     31783,  31801,  31820,  31838,  31856,  31874,  31892,  31909,  31927,  31944,  31961,  31978,
+     31995,  32011,  32028,  32044,  32060,  32076,  32091,  32107,  32122,  32137,  32152,  32167,
+     32182,  32196,  32210,  32224,  32238,  32252,  32266,  32279,  32292,  32305,  32318,  32331,
+     32343,  32356,  32368,  32380,  32391,  32403,  32414,  32426,  32437,  32448,  32458,  32469,
+     32479,  32489,  32499,  32509,  32519,  32528,  32537,  32546,  32555,  32564,  32573,  32581,
+     32589,  32597,  32605,  32612,  32620,  32627,  32634,  32641,  32648,  32654,  32661,  32667,
+     32673,  32679,  32684,  32690,  32695,  32700,  32705,  32709,  32714,  32718,  32722,  32726,
+     32730,  32734,  32737,  32740,  32743,  32746,  32749,  32751,  32754,  32756,  32758,  32760,
+     32761,  32762,  32764,  32765,  32766,  32766,  32767,  32767,  32767,
+};
+
+/* Blackman-Harris 4 项 (-92 dB): a0=0.35875, a1=0.48829, a2=0.14128, a3=0.01168 */
+static const q15_t s_WinBlackmanHarris[WIN_TABLE_LEN / 2 + 1] = {
+         2,      2,      2,      2,      2,      2,      2,      2,      2,      2,      2,      2,
+         2,      2,      2,      2,      2,      2,      2,      2,      2,      2,      2,      3,
+         3,      3,      3,      3,      3,      3,      3,      3,      3,      3,      3,      3,
+         3,      3,      4,      4,      4,      4,      4,      4,      4,      4,      4,      4,
+         5,      5,      5,      5,      5,      5,      5,      5,      5,      6,      6,      6,
+         6,      6,      6,      6,      7,      7,      7,      7,      7,      7,      7,      8,
+         8,      8,      8,      8,      8,      9,      9,      9,      9,      9,     10,     10,
+        10,     10,     10,     11,     11,     11,     11,     11,     12,     12,     12,     12,
+        13,     13,     13,     13,     13,     14,     14,     14,     14,     15,     15,     15,
+        16,     16,     16,     16,     17,     17,     17,     17,     18,     18,     18,     19,
+        19,     19,     20,     20,     20,     21,     21,     21,     22,     22,     22,     23,
+        23,     23,     24,     24,     24,     25,     25,     25,     26,     26,     26,     27,
+        27,     28,     28,     28,     29,     29,     30,     30,     30,     31,     31,     32,
+        32,     33,     33,     34,     34,     34,     35,     35,     36,     36,     37,     37,
+        38,     38,     39,     39,     40,     40,     41,     41,     42,     42,     43,     43,
+        44,     44,     45,     45,     46,     47,     47,     48,     48,     49,     49,     50,
+        51,     51,     52,     52,     53,     54,     54,     55,     56,     56,     57,     58,
+        58,     59,     59,     60,     61,     62,     62,     63,     64,     64,     65,     66,
+        66,     67,     68,     69,     69,     70,     71,     72,     72,     73,     74,     75,
+        76,     76,     77,     78,     79,     80,     80,     81,     82,     83,     84,     85,
+        85,     86,     87,     88,     89,     90,     91,     92,     93,     94,     95,     95,
+        96,     97,     98,     99,    100,    101,    102,    103,    104,    105,    106,    107,
+       108,    109,    110,    111,    112,    114,    115,    116,    117,    118,    119,    120,
+       121,    122,    124,    125,    126,    127,    128,    129,    131,    132,    133,    134,
+       135,    137,    138,    139,    140,    142,    143,    144,    145,    147,    148,    149,
+       151,    152,    153,    155,    156,    157,    159,    160,    162,    163,    164,    166,
+       167,    169,    170,    172,    173,    175,    176,    177,    179,    181,    182,    184,
+       185,    187,    188,    190,    191,    193,    195,    196,    198,    200,    201,    203,
+       204,    206,    208,    210,    211,    213,    215,    216,    218,    220,    222,    224,
+       225,    227,    229,    231,    233,    235,    236,    238,    240,    242,    244,    246,
+       248,    250,    252,    254,    256,    258,    260,    262,    264,    266,    268,    270,
+       272,    274,    276,    278,    281,    283,    285,    287,    289,    291,    294,    296,
+       298,    300,    303,    305,    307,    309,    312,    314,    316,    319,    321,    324,
+       326,    328,    331,    333,    336,    338,    341,    343,    346,    348,    351,    353,
+       356,    358,    361,    364,    366,    369,    371,    374,    377,    379,    382,    385,
+       388,    390,    393,    396,    399,    402,    404,    407,    410,    413,    416,    419,
+       422,    425,    428,    431,    434,    437,    440,    443,    446,    449,    452,    455,
+       458,    461,    464,    468,    471,    474,    477,    480,    484,    487,    490,    493,
+       497,    500,    503,    507,    510,    514,    517,    521,    524,    527,    531,    534,
+       538,    542,    545,    549,    552,    556,    560,    563,    567,    571,    574,    578,
+       582,    586,    589,    593,    597,    601,    605,    609,    613,    616,    620,    624,
+       628,    632,    636,    640,    644,    649,    653,    657,    661,    665,    669,    673,
+       678,    682,    686,    690,    695,    699,    703,    708,    712,    717,    721,    726,
+       730,    734,    739,    744,    748,    753,    757,    762,    767,    771,    776,    781,
+       785,    790,    795,    800,    804,    809,    814,    819,    824,    829,    834,    839,
+       844,    849,    854,    859,    864,    869,    874,    879,    885,    890,    895,    900,
+       906,    911,    916,    922,    927,    932,    938,    943,    949,    954,    960,    965,
+       971,    976,    982,    988,    993,    999,   1005,   1010,   1016,   1022,   1028,   1034,
+      1039,   1045,   1051,   1057,   1063,   1069,   1075,   1081,   1087,   1093,   1099,   1106,
+      1112,   1118,   1124,   1130,   1137,   1143,   1149,   1156,   1162,   1168,   1175,   1181,
+      1188,   1194,   1201,   1207,   1214,   1221,   1227,   1234,   1241,   1247,   1254,   1261,
+      1268,   1275,   1281,   1288,   1295,   1302,   1309,   1316,   1323,   1330,   1337,   1344,
+      1352,   1359,   1366,   1373,   1381,   1388,   1395,   1402,   1410,   1417,   1425,   1432,
+      1440,   1447,   1455,   1462,   1470,   1478,   1485,   1493,   1501,   1508,   1516,   1524,
+      1532,   1540,   1548,   1556,   1564,   1572,   1580,   1588,   1596,   1604,   1612,   1620,
+      1629,   1637,   1645,   1653,   1662,   1670,   1679,   1687,   1695,   1704,   1712,   1721,
+      1730,   1738,   1747,   1756,   1764,   1773,   1782,   1791,   1800,   1808,   1817,   1826,
+      1835,   1844,   1853,   1862,   1872,   1881,   1890,   1899,   1908,   1918,   1927,   1936,
+      1946,   1955,   1964,   1974,   1983,   1993,   2003,   2012,   2022,   2032,   2041,   2051,
+      2061,   2071,   2080,   2090,   2100,   2110,   2120,   2130,   2140,   2150,   2161,   2171,
+      2181,   2191,   2201,   2212,   2222,   2232,   2243,   2253,   2264,   2274,   2285,   2295,
+      2306,   2317,   2327,   2338,   2349,   2360,   2370,   2381,   2392,   2403,   2414,   2425,
+      2436,   2447,   2458,   2470,   2481,   2492,   2503,   2515,   2526,   2537,   2549,   2560,
+      2572,   2583,   2595,   2606,   2618,   2630,   2641,   2653,   2665,   2677,   2689,   2701,
+      2712,   2724,   2736,   2749,   2761,   2773,   2785,   2797,   2809,   2822,   2834,   2846,
+      2859,   2871,   2884,   2896,   2909,   2921,   2934,   2947,   2959,   2972,   2985,   2998,
+      3010,   3023,   3036,   3049,   3062,   3075,   3088,   3102,   3115,   3128,   3141,   3155,
+      3168,   3181,   3195,   3208,   3222,   3235,   3249,   3262,   3276,   3290,   3303,   3317,
+      3331,   3345,   3359,   3373,   3387,   3401,   3415,   3429,   3443,   3457,   3471,   3485,
+      3500,   3514,   3528,   3543,   3557,   3572,   3586,   3601,   3616,   3630,   3645,   3660,
+      3675,   3689,   3704,   3719,   3734,   3749,   3764,   3779,   3794,   3809,   3825,   3840,
+      3855,   3871,   3886,   3901,   3917,   3932,   3948,   3963,   3979,   3995,   4010,   4026,
+      4042,   4058,   4074,   4089,   4105,   4121,   4137,   4154,   4170,   4186,   4202,   4218,
+      4235,   4251,   4267,   4284,   4300,   4317,   4333,   4350,   4366,   4383,   4400,   4417,
+      4433,   4450,   4467,   4484,   4501,   4518,   4535,   4552,   4569,   4587,   4604,   4621,
+      4638,   4656,   4673,   4691,   4708,   4726,   4743,   4761,   4779,   4796,   4814,   4832,
+      4850,   4868,   4886,   4904,   4922,   4940,   4958,   4976,   4994,   5012,   5031,   5049,
+      5067,   5086,   5104,   5123,   5141,   5160,   5178,   5197,   5216,   5235,   5253,   5272,
+      5291,   5310,   5329,   5348,   5367,   5386,   5405,   5425,   5444,   5463,   5482,   5502,
+      5521,   5541,   5560,   5580,   5599,   5619,   5639,   5658,   5678,   5698,   5718,   5738,
+      5758,   5778,   5798,   5818,   5838,   5858,   5878,   5898,   5919,   5939,   5960,   5980,
+      6000,   6021,   6042,   6062,   6083,   6103,   6124,   6145,   6166,   6187,   6208,   6229,
+      6250,   6271,   6292,   6313,   6334,   6355,   6377,   6398,   6419,   6441,   6462,   6484,
+      6505,   6527,   6548,   6570,   6592,   6613,   6635,   6657,   6679,   6701,   6723,   6745,
+      6767,   6789,   6811,   6833,   6856,   6878,   6900,   6923,   6945,   6967,   6990,   7012,
+      7035,   7058,   7080,   7103,   7126,   7149,   7171,   7194,   7217,   7240,   7263,   7286,
+      7309,   7333,   7356,   7379,   7402,   7426,   7449,   7472,   7496,   7519,   7543,   7567,
+      7590,   7614,   7638,   7661,   7685,   7709,   7733,   7757,   7781,   7805,   7829,   7853,
+      7877,   7901,   7925,   7950,   7974,   7998,   8023,   8047,   8072,   8096,   8121,   8145,
+      8170,   8195,   8220,   8244,   8269,   8294,   8319,   8344,   8369,   8394,   8419,   8444,
+      8469,   8494,   8520,   8545,   8570,   8596,   8621,   8646,   8672,   8697,   8723,   8749,
+      8774,   8800,   8826,   8852,   8877,   8903,   8929,   8955,   8981,   9007,   9033,   9059,
+      9085,   9112,   9138,   9164,   9190,   9217,   9243,   9270,   9296,   9323,   9349,   9376,
+      9402,   9429,   9456,   9482,   9509,   9536,   9563,   9590,   9617,   9644,   9671,   9698,
+      9725,   9752,   9779,   9806,   9834,   9861,   9888,   9916,   9943,   9971,   9998,  10026,
+     10053,  10081,  10108,  10136,  10164,  10192,  10219,  10247,  10275,  10303,  10331,  10359,
+     10387,  10415,  10443,  10471,  10499,  10528,  10556,  10584,  10613,  10641,  10669,  10698,
+     10726,  10755,  10783,  10812,  10840,  10869,  10898,  10926,  10955,  10984,  11013,  11042,
+     11071,  11100,  11129,  11158,  11187,  11216,  11245,  11274,  11303,  11332,  11362,  11391,
+     11420,  11450,  11479,  11508,  11538,  11567,  11597,  11626,  11656,  11686,  11715,  11745,
+     11775,  11804,  11834,  11864,  11894,  11924,  11954,  11984,  12014,  12044,  12074,  12104,
+     12134,  12164,  12194,  12224,  12255,  12285,  12315,  12346,  12376,  12406,  12437,  12467,
+     12498,  12528,  12559,  12589,  12620,  12651,  12681,  12712,  12743,  12774,  12804,  12835,
+     12866,  12897,  12928,  12959,  12990,  13021,  13052,  13083,  13114,  13145,  13176,  13207,
+     13239,  13270,  13301,  13332,  13364,  13395,  13426,  13458,  13489,  13521,  13552,  13584,
+     13615,  13647,  13678,  13710,  13741,  13773,  13805,  13837,  13868,  13900,  13932,  13964,
+     13995,  14027,  14059,  14091,  14123,  14155,  14187,  14219,  14251,  14283,  14315,  14347,
+     14379,  14412,  14444,  14476,  14508,  14540,  14573,  14605,  14637,  14670,  14702,  14734,
+     14767,  14799,  14832,  14864,  14896,  14929,  14962,  14994,  15027,  15059,  15092,  15124,
+     15157,  15190,  15222,  15255,  15288,  15321,  15353,  15386,  15419,  15452,  15485,  15518,
+     15550,  15583,  15616,  15649,  15682,  15715,  15748,  15781,  15814,  15847,  15880,  15913,
+     15946,  15979,  16013,  16046,  16079,  16112,  16145,  16178,  16212,  16245,  16278,  16311,
+     16345,  16378,  16411,  16445,  16478,  16511,  16545,  16578,  16611,  16645,  16678,  16712,
+     16745,  16778,  16812,  16845,  16879,  16912,  16946,  16979,  17013,  17046,  17080,  17114,
+     17147,  17181,  17214,  17248,  17282,  17315,  17349,  17383,  17416,  17450,  17484,  17517,
+     17551,  17585,  17618,  17652,  17686,  17720,  17753,  17787,  17821,  17855,  17888,  17922,
+     17956,  17990,  18023,  18057,  18091,  18125,  18159,  18193,  18226,  18260,  18294,  18328,
+     18362,  18396,  18430,  18463,  18497,  18531,  18565,  18599,  18633,  18667,  18701,  18734,
+     18768,  18802,  18836,  18870,  18904,  18938,  18972,  19006,  19040,  19073,  19107,  19141,
+     19175,  19209,  19243,  19277,  19311,  19345,  19379,  19413,  19446,  19480,  19514,  19548,
+     19582,  19616,  19650,  19684,  19718,  19752,  19785,  19819,  19853,  19887,  19921,  19955,
+     19989,  20022,  20056,  20090,  20124,  20158,  20192,  20226,  20259,  20293,  20327,  20361,
+     20395,  20428,  20462,  20496,  20530,  20563,  20597,  20631,  20665,  20698,  20732,  20766,
+     20800,  20833,  20867,  20901,  20934,  20968,  21002,  21035,  21069,  21102,  21136,  21170,
+     21203,  21237,  21270,  21304,  21337,  21371,  21404,  21438,  21471,  21505,  21538,  21572,
+     21605,  21639,  21672,  21705,  21739,  21772,  21806,  21839,  21872,  21905,  21939,  21972,
+     22005,  22039,  22072,  22105,  22138,  22171,  22204,  22238,  22271,  22304,  22337,  22370,
+     22403,  22436,  22469,  22502,  22535,  22568,  22601,  22634,  22667,  22700,  22732,  22765,
+     22798,  22831,  22864,  22896,  22929,  22962,  22995,  23027,  23060,  23092,  23125,  23158,
+     23190,  23223,  23255,  23288,  23320,  23353,  23385,  23417,  23450,  23482,  23514,  23547,
+     23579,  23611,  23643,  23676,  23708,  23740,  23772,  23804,  23836,  23868,  23900,  23932,
+     23964,  23996,  24028,  24060,  24091,  24123,  24155,  24187,  24218,  24250,  24282,  24313,
+     24345,  24376,  24408,  24439,  24471,  24502,  24534,  24565,  24596,  24628,  24659,  24690,
+     24721,  24753,  24784,  24815,  24846,  24877,  24908,  24939,  24970,  25001,  25032,  25062,
+     25093,  25124,  25155,  25185,  25216,  25247,  25277,  25308,  25338,  25369,  25399,  25430,
+     25460,  25490,  25521,  25551,  25581,  25611,  25641,  25671,  25701,  25731,  25761,  25791,
+     25821,  25851,  25881,  25911,  25940,  25970,  26000,  26029,  26059,  26088,  26118,  26147,
+     26177,  26206,  26235,  26265,  26294,  26323,  26352,  26381,  26410,  26439,  26468,  26497,
+     26526,  26555,  26584,  26612,  26641,  26670,  26698,  26727,  26755,  26784,  26812,  26841,
+     26869,  26897,  26925,  26954,  26982,  27010,  27038,  27066,  27094,  27122,  27150,  27177,
+     27205,  27233,  27260,  27288,  27316,  27343,  27370,  27398,  27425,  27453,  27480,  27507,
+     27534,  27561,  27588,  27615,  27642,  27669,  27696,  27723,  27749,  27776,  27803,  27829,
+     27856,  27882,  27908,  27935,  27961,  27987,  28014,  28040,  28066,  28092,  28118,  28144,
+     28169,  28195,  28221,  28247,  28272,  28298,  28323,  28349,  28374,  28399,  28425,  28450,
+     28475,  28500,  28525,  28550,  28575,  28600,  28625,  28650,  28674,  28699,  28724,  28748,
+     28772,  28797,  28821,  28845,  28870,  28894,  28918,  28942,  28966,  28990,  29014,  29037,
+     29061,  29085,  29108,  29132,  29155,  29179,  29202,  29225,  29249,  29272,  29295,  29318,
+     29341,  29364,  29387,  29409,  29432,  29455,  29477,  29500,  29522,  29545,  29567,  29589,
+     29611,  29633,  29655,  29677,  29699,  29721,  29743,  29765,  29786,  29808,  29829,  29851,
+     29872,  29893,  29915,  29936,  29957,  29978,  29999,  30020,  30041,  30061,  30082,  30103,
+     30123,  30144,  30164,  30184,  30205,  30225,  30245,  30265,  30285,  30305,  30325,  30345,
+     30364,  30384,  30403,  30423,  30442,  30462,  30481,  30500,  30519,  30538,  30557,  30576,
+     30595,  30614,  30632,  30651,  30670,  30688,  30706,  30725,  30743,  30761,  30779,  30797,
+     30815,  30833,  30851,  30868,  30886,  30904,  30921,  30939,  30956,  30973,  30990,  31007,
+     31024,  31041,  31058,  31075,  31092,  31108,  31125,  31142,  31158,  31174,  31191,  31207,
+     31223,  31239,  31255,  31271,  31286,  31302,  31318,  31333,  31349,  31364,  31380,  31395,
+     31410,  31425,  31440,  31455,  31470,  31485,  31499,  31514,  31528,  31543,  31557,  31572,
+     31586,  31600,  31614,  31628,  31642,  31656,  31669,  31683,  31696,  31710,  31723,  31737,
+     31750,  31763,  31776,  31789,  31802,  31815,  31828,  31840,  31853,  31865,  31878,  31890,
+     31902,  31914,  31926,  31938,  31950,  31962,  31974,  31986,  31997,  32009,  32020,  32031,
+     32043,  32054,  32065,  32076,  32087,  32098,  32108,  32119,  32130,  32140,  32150,  32161,
+     32171,  32181,  32191,  32201,  32211,  32221,  32231,  32240,  32250,  32259,  32269,  32278,
+     32287,  32296,  32305,  32314,  32323,  32332,  32341,  32349,  32358,  32366,  32375,  32383,
+     32391,  32399,  32407,  32415,  32423,  32431,  32438,  32446,  32453,  32461,  32468,  32475,
+     32482,  32489,  32496,  32503,  32510,  32517,  32523,  32530,  32536,  32543,  32549,  32555,
+     32561,  32567,  32573,  32579,  32585,  32590,  32596,  32601,  32607,  32612,  32617,  32622,
+     32627,  32632,  32637,  32642,  32646,  32651,  32656,  32660,  32664,  32668,  32673,  32677,
+     32681,  32685,  32688,  32692,  32696,  32699,  32703,  32706,  32709,  32712,  32715,  32718,
+     32721,  32724,  32727,  32729,  32732,  32734,  32737,  32739,  32741,  32743,  32745,  32747,
+     32749,  32751,  32753,  32754,  32756,  32757,  32758,  32759,  32761,  32762,  32763,  32763,
+     32764,  32765,  32765,  32766,  32766,  32767,  32767,  32767,  32767,
+};
+
+const WinInfo_t g_WinInfo[WIN_TYPE_NUM] = {
+    [WIN_RECT] = { NULL, 1.0f, 1.0f, { 0.0f, 0.0f, 0.0f, 0.0f } },
+    [WIN_HANN] = { s_WinHann, 0.499999993f, 0.375000394f, { -1.0f, 0.0f, 0.0f, 0.0f } },
+    [WIN_HAMMING] = { s_WinHamming, 0.54000008f, 0.397400218f, { -0.851851852f, 0.0f, 0.0f, 0.0f } },
+    [WIN_FLATTOP] = { s_WinFlatTop, 0.215578839f, 0.175219453f, { -1.93261717f, 1.2861328f, -0.387695306f, 0.0322265602f } },
+    [WIN_BLACKMAN_HARRIS] = { s_WinBlackmanHarris, 0.358750183f, 0.257963415f, { -1.36108711f, 0.393811847f, -0.0325574913f, 0.0f } },
+};
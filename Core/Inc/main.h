@@ -41,6 +41,8 @@ extern "C" {
 #include "protocol.h"
 #include "Eigenvalue calculation.h"
 #include "flash.h"
+#include "trigger.h"
+#include "uart_rx.h"
 
 /* USER CODE END Includes */
 
@@ -79,24 +81,93 @@ void Error_Handler(void);
 #define KX134_CS_GPIO_Port GPIOA
 
 /* USER CODE BEGIN Private defines */
-#define UART_RX_BUF_SIZE  1024
+#define UART_RX_BUF_SIZE  1024     // 串口接收环 (循环 DMA，2 的幂)
 #define FFT_POINTS        4096
 #define AXIS_COUNT        3
-extern int16_t g_SensorRawBuffer[2][FFT_POINTS * AXIS_COUNT];
+// 帧缓冲池: DataTask 从空闲队列取帧写满后放入就绪队列，AlgoTask 从就绪队列取帧，处理完归还空闲队列，
+// 采集永远不会写入算法仍持有的帧。每帧 FFT_POINTS * AXIS_COUNT * 2 = 24KB，4096 点时 RAM 只放得下 2 个
+#define FRAME_POOL_SLOTS    2       // 2 ~ 4
+#define FRAME_DROP_NEWEST   0       // 无空闲帧时丢弃刚采完的帧，原地继续写
+#define FRAME_DROP_OLDEST   1       // 无空闲帧时回收最早的未处理帧 (2 槽时最早的就是刚采完的帧，与上面等价)
+#define FRAME_DROP_POLICY   FRAME_DROP_OLDEST
+// 帧内按轴分平面存放 (SoA): X[0..FFT_POINTS) Y[..] Z[..]，由 SPI DMA 完成中断从 FIFO 的交错数据拆分写入
+#define RAW_AXIS(pFrame, k) ((pFrame) + (uint32_t)(k) * FFT_POINTS)
+extern int16_t g_SensorRawBuffer[FRAME_POOL_SLOTS][FFT_POINTS * AXIS_COUNT];
+
+// 采集块时间戳与完整性 (DataTask 写，按帧槽位；CMD_ACQ_INFO 上报)
+#define ACQ_BLOCK_LOG       64      // 每帧记录的块时间戳上限
+#define ACQ_FLAG_OVERRUN    0x01    // 帧内 FIFO 溢出，有采样被覆盖
+#define ACQ_FLAG_TIMEOUT    0x02    // 帧内 SPI DMA 超时，FIFO 已清空
+#define ACQ_FLAG_LOG_FULL   0x04    // 块数超过 ACQ_BLOCK_LOG，之后的块未记时间戳 (数据完整)
+#define ACQ_FLAG_RES8       0x08    // 帧以 8 位分辨率采集 (每个采样低 8 位为 0)
+#define ACQ_FLAG_RECONF     0x10    // 采样率/分辨率切换后的第一帧
+#define ACQ_FLAG_ADP        0x20    // 数据经传感器 ADP 滤波 (g_cfg_adp)，不是原始加速度
+#define ACQ_FLAG_ADP_ENV    0x40    // ADP 带通落在包络共振带内，包络谱不再做带通
+#define ACQ_FLAG_ADP_RMS    0x80    // 缓冲区为 ADP 滑动 RMS 值，不是波形
+#define ACQ_FLAG_BAD_MASK   (ACQ_FLAG_OVERRUN | ACQ_FLAG_TIMEOUT)
 typedef struct {
-    uint8_t write_index; // 当前 DMA 正在写哪
-    uint8_t read_index;  // 当前 算法 正在读哪
-    volatile uint8_t data_ready_flag; // 标志位：1表示有一半数据准备好
-} PingPong_Mgr_t;//乒乓状�??
-extern PingPong_Mgr_t g_PingPongMgr;
+    uint32_t cycles;        // 读 BUF_STATUS 时的 DWT->CYCCNT，此刻本块最后一个采样已到达
+    uint16_t offset;        // 块在帧内的起始采样
+    uint16_t count;         // 块采样数
+} AcqBlockStamp_t;
+typedef struct {
+    uint32_t seq;           // 帧序号
+    uint32_t firstSample;   // 帧首采样的全局序号 (g_AcqStats.samples 计数)
+    uint32_t tick;          // 帧完成时的 RTOS tick
+    float    odrMeas;       // 由首末块时间戳测得的实际 ODR (Hz，按 SystemCoreClock 换算)，0 = 无法测量
+    uint16_t blocks;        // 块数
+    uint16_t odr;           // 采集时的名义 ODR (Hz)
+    uint8_t  flags;         // ACQ_FLAG_xxx
+} AcqFrameInfo_t;
+typedef struct {
+    uint32_t samples;       // 累计写入帧缓冲的采样数
+    uint32_t overruns;      // FIFO 溢出次数
+    uint32_t timeouts;      // SPI DMA 超时次数
+    uint32_t gaps;          // 数据不连续次数 (溢出 + 超时)
+    uint32_t lostSamples;   // 丢失采样数估计 (按名义 ODR 与时间戳推算)
+    uint32_t badFrames;     // 含 ACQ_FLAG_BAD_MASK 的帧数
+    uint32_t droppedFrames; // 算法来不及处理、被帧缓冲池丢弃的帧数
+    uint32_t reconfigs;     // 采样率/分辨率切换次数
+    uint32_t reconfUs;      // 最近一次切换从请求到生效的时间 (us)
+} AcqStats_t;
+extern AcqBlockStamp_t g_AcqBlockLog[FRAME_POOL_SLOTS][ACQ_BLOCK_LOG];
+void Acq_GetLastFrame(AcqFrameInfo_t *info, AcqStats_t *stats);   // 最近一个完成帧 + 累计统计
+#define ACQ_RECONF_KEEP     0xFF
+void Acq_RequestReconfig(uint16_t odr, uint8_t res8, const KX134_Adp_t *adp);   // CommTask 调用: odr = 0 / res8 = ACQ_RECONF_KEEP / adp = NULL 表示不变，DataTask 在块边界切换
+uint8_t Acq_ConfigFlags(void);      // 当前采集配置对应的 ACQ_FLAG_xxx (分辨率、ADP)
+
+// 长记录: 收回整个帧缓冲池作为单轴线性缓冲 (可抽取、可压成 8 位)，从开始记录到上位机释放期间暂停分析
+#define LREC_STATE_IDLE     0       // 未使用 (释放后 DataTask 归还帧缓冲池)
+#define LREC_STATE_ARMED    1       // 已请求，等 DataTask 收回帧缓冲池
+#define LREC_STATE_RUN      2       // 记录中
+#define LREC_STATE_DONE     3       // 记录完成，缓冲冻结等待读取
+#define LREC_DECIM_MAX      64      // 抽取倍数上限 (相邻 decim 点取平均)
+#define LREC_SCRATCH        (AXIS_COUNT * KX134_FIFO_MAX_SAMPLES_8BIT)    // 缓冲末尾留作 FIFO 搬运暂存 (int16)
+#define LREC_WORDS          (FRAME_POOL_SLOTS * FFT_POINTS * AXIS_COUNT - LREC_SCRATCH)
+typedef struct {
+    uint8_t  state;         // LREC_STATE_xxx
+    uint8_t  axis;          // 0 X 1 Y 2 Z
+    uint8_t  decim;         // 抽取倍数，记录采样率 = odr / decim
+    uint8_t  pack8;         // 1 = 每点只存高 8 位，容量加倍
+    uint8_t  flags;         // ACQ_FLAG_xxx: 记录期间的溢出/超时
+    uint16_t odr;           // 记录时的 ODR (Hz)
+    uint32_t target;        // 请求点数 (抽取后)
+    uint32_t count;         // 已记录点数
+    uint32_t firstSample;   // 首个输入采样的全局序号 (g_AcqStats.samples 计数)
+    uint32_t tickStart;
+    uint32_t tickEnd;
+} LRecInfo_t;
+uint8_t LRec_Start(uint8_t axis, uint8_t decim, uint8_t pack8, uint32_t points);   // points = 0 记满，返回 0 表示参数无效或正在记录
+void LRec_Release(void);                                   // 终止记录 / 读取完成，恢复正常采集与分析
+void LRec_GetInfo(LRecInfo_t *info);
+uint16_t LRec_Read(float *out, uint32_t from, uint16_t n); // 记录完成后读 [from, from+n) (g)，返回实际点数
 extern uint8_t LOCAL_DEVICE_ADDR;
 extern uint16_t g_cfg_freq_hz;
-extern volatile uint8_t g_ResetAcqReq; 
+extern uint8_t g_cfg_window;
+extern uint8_t g_cfg_res8;
+extern KX134_Adp_t g_cfg_adp;
 
-extern uint8_t rx_dma_buf[UART_RX_BUF_SIZE];  
-extern uint8_t g_UartRxBuffer[UART_RX_BUF_SIZE];
-extern volatile uint16_t g_UartRxLen;//实际接收字节
-void Uart1_RxStart(void);
+void Uart1_SetBaud(uint32_t baud);
 
 /* USER CODE END Private defines */
 
@@ -52,6 +52,24 @@ extern IWDG_HandleTypeDef hiwdg;
 /* Private variables ---------------------------------------------------------*/
 /* USER CODE BEGIN Variables */
 SemaphoreHandle_t DmaCpltSem;
+static QueueHandle_t  s_FrameFreeQ;     // 空闲帧槽位 (DataTask 取)
+static QueueHandle_t  s_FrameReadyQ;    // 已采满待处理的帧槽位 (AlgoTask 取)，先进先出
+AcqBlockStamp_t g_AcqBlockLog[FRAME_POOL_SLOTS][ACQ_BLOCK_LOG];
+static AcqFrameInfo_t s_AcqFrame[FRAME_POOL_SLOTS];    // 按帧槽位
+static AcqFrameInfo_t s_AcqLast;        // 最近完成的帧 (供协议读取)
+static AcqStats_t     s_AcqStats;
+static uint32_t       s_AcqSeq = 0;
+static LRecInfo_t     s_LRec;           // 长记录状态 (CommTask 请求/释放，DataTask 执行)
+static int32_t        s_LRecAcc = 0;    // 抽取累加
+static uint8_t        s_LRecAccN = 0;
+static struct {
+    volatile uint8_t pending;
+    uint8_t  res8;              // ACQ_RECONF_KEEP = 不变
+    uint8_t  adpSet;            // 1 = 更新 adp
+    KX134_Adp_t adp;
+    uint16_t odr;               // 0 = 不变
+    uint32_t reqCyc;            // 最早一个未执行请求的 DWT->CYCCNT
+} s_AcqReconf;                  // 配置切换请求 (CommTask 写，DataTask 在块边界执行)
 /* USER CODE END Variables */
 /* Definitions for defaultTask */
 osThreadId_t defaultTaskHandle;
@@ -67,6 +85,7 @@ const osThreadAttr_t defaultTask_attributes = {
 void DataTask_Entry(void *argument);
 void AlgoTask_Entry(void *argument);
 void CommTask_Entry(void *argument);
+static void FramePool_Init(void);
 
 /* USER CODE END FunctionPrototypes */
 
@@ -153,6 +172,8 @@ void MX_FREERTOS_Init(void) {
 void StartDefaultTask(void *argument)
 {
   /* USER CODE BEGIN StartDefaultTask */
+  FramePool_Init();   // 须在采集/算法任务运行前建好队列
+  UartTx_Init();      // 须在 CommTask 运行前建好发送缓冲池
   xTaskCreate(DataTask_Entry, "DataTask", 512, NULL, osPriorityHigh, &DataTaskHandle); 
   xTaskCreate(AlgoTask_Entry, "AlgoTask", 2048, NULL, osPriorityAboveNormal, &AlgoTaskHandle);
   xTaskCreate(CommTask_Entry, "CommTask", 512, NULL, osPriorityNormal, &CommTaskHandle);
@@ -170,41 +191,447 @@ void StartDefaultTask(void *argument)
 /* Private application code --------------------------------------------------*/
 /* USER CODE BEGIN Application */
 
+#if FRAME_POOL_SLOTS < 2 || FRAME_POOL_SLOTS > 4
+#error "FRAME_POOL_SLOTS must be 2..4"
+#endif
+
+// 帧缓冲池: 槽位号在两个队列间传递，谁从队列取到谁独占该帧。
+// 槽位 0 归 DataTask，其余放入空闲队列，返回 DataTask 的写入槽位
+static uint8_t FramePool_Restore(void)
+{
+    for (uint8_t i = 1; i < FRAME_POOL_SLOTS; i++) {
+        xQueueSend(s_FrameFreeQ, &i, 0);
+    }
+    return 0;
+}
+
+static void FramePool_Init(void)
+{
+    s_FrameFreeQ = xQueueCreate(FRAME_POOL_SLOTS, sizeof(uint8_t));
+    s_FrameReadyQ = xQueueCreate(FRAME_POOL_SLOTS, sizeof(uint8_t));
+    FramePool_Restore();
+}
+
+// DataTask: 收回全部槽位 (长记录)。未处理的帧直接作废，AlgoTask 正在处理的帧等它归还
+static void FramePool_Reclaim(void)
+{
+    uint8_t slot;
+    uint8_t got = 1;               // 正在写的槽位本来就归 DataTask
+    // 就绪队列只有 DataTask 写入，清空后剩下的槽位只会经 FramePool_Release 回到空闲队列
+    while (xQueueReceive(s_FrameReadyQ, &slot, 0) == pdTRUE) {
+        s_AcqStats.droppedFrames++;
+        got++;
+    }
+    while (got < FRAME_POOL_SLOTS) {
+        if (xQueueReceive(s_FrameFreeQ, &slot, portMAX_DELAY) == pdTRUE) got++;
+    }
+}
+
+// DataTask: 提交写满的帧，返回下一个要写的槽位。没有空闲帧时按 FRAME_DROP_POLICY 丢帧
+static uint8_t FramePool_Submit(uint8_t slot)
+{
+    uint8_t next;
+#if FRAME_DROP_POLICY == FRAME_DROP_NEWEST
+    if (xQueueReceive(s_FrameFreeQ, &next, 0) != pdTRUE) {
+        // 丢弃刚采满的帧，原地重写
+        s_AcqStats.droppedFrames++;
+        return slot;
+    }
+    xQueueSend(s_FrameReadyQ, &slot, 0);
+#else
+    xQueueSend(s_FrameReadyQ, &slot, 0);
+    if (xQueueReceive(s_FrameFreeQ, &next, 0) != pdTRUE) {
+        // 回收最早的未处理帧 (AlgoTask 持有的帧不在队列中；刚放入的帧保证队列非空)
+        xQueueReceive(s_FrameReadyQ, &next, 0);
+        s_AcqStats.droppedFrames++;
+    }
+#endif
+    return next;
+}
+
+// AlgoTask: 阻塞等待一帧，处理完必须 FramePool_Release 归还
+static uint8_t FramePool_Take(void)
+{
+    uint8_t slot;
+    while (xQueueReceive(s_FrameReadyQ, &slot, portMAX_DELAY) != pdTRUE) {
+    }
+    return slot;
+}
+
+static void FramePool_Release(uint8_t slot)
+{
+    xQueueSend(s_FrameFreeQ, &slot, 0);
+}
+
+static void Acq_FrameStart(uint8_t slot)
+{
+    AcqFrameInfo_t *fi = &s_AcqFrame[slot];
+    fi->seq = s_AcqSeq++;
+    fi->firstSample = s_AcqStats.samples;
+    fi->blocks = 0;
+    fi->odr = g_cfg_freq_hz;
+    fi->flags = Acq_ConfigFlags();
+}
+
+// 记录一块: cycles 为读 BUF_STATUS 的时刻
+static void Acq_BlockStamp(uint8_t slot, uint32_t cycles, uint16_t offset, uint16_t count)
+{
+    AcqFrameInfo_t *fi = &s_AcqFrame[slot];
+    if (fi->blocks < ACQ_BLOCK_LOG) {
+        AcqBlockStamp_t *b = &g_AcqBlockLog[slot][fi->blocks];
+        b->cycles = cycles;
+        b->offset = offset;
+        b->count = count;
+        fi->blocks++;
+    } else {
+        fi->flags |= ACQ_FLAG_LOG_FULL;
+    }
+    s_AcqStats.samples += count;
+}
+
+static void Acq_FrameFinish(uint8_t slot)
+{
+    AcqFrameInfo_t *fi = &s_AcqFrame[slot];
+    fi->tick = xTaskGetTickCount();
+    fi->odrMeas = 0.0f;
+    if (fi->blocks >= 2) {
+        const AcqBlockStamp_t *b0 = &g_AcqBlockLog[slot][0];
+        const AcqBlockStamp_t *b1 = &g_AcqBlockLog[slot][fi->blocks - 1];
+        uint32_t dc = b1->cycles - b0->cycles;
+        uint32_t ds = (uint32_t)(b1->offset + b1->count) - (uint32_t)(b0->offset + b0->count);
+        if (dc != 0) fi->odrMeas = (float)ds * (float)SystemCoreClock / (float)dc;
+    }
+    if (fi->flags & ACQ_FLAG_BAD_MASK) s_AcqStats.badFrames++;
+
+    taskENTER_CRITICAL();
+    s_AcqLast = *fi;
+    taskEXIT_CRITICAL();
+}
+
+void Acq_GetLastFrame(AcqFrameInfo_t *info, AcqStats_t *stats)
+{
+    taskENTER_CRITICAL();
+    *info = s_AcqLast;
+    *stats = s_AcqStats;
+    taskEXIT_CRITICAL();
+}
+
+// ADP 带通 (两级都生效) 落在包络共振带内时，包络谱直接使用传感器滤波结果
+uint8_t Acq_ConfigFlags(void)
+{
+    uint8_t flags = g_cfg_res8 ? ACQ_FLAG_RES8 : 0;
+    const KX134_Adp_t *adp = &g_cfg_adp;
+    if (adp->mode == KX134_ADP_OFF) return flags;
+
+    flags |= ACQ_FLAG_ADP;
+    if (adp->mode == KX134_ADP_RMS) return flags | ACQ_FLAG_ADP_RMS;
+    float fcMax = KX134_ADP_FC_MAX_RATIO * (float)g_cfg_freq_hz;
+    if (adp->hpf_hz >= ENV_BP_LO_HZ && adp->hpf_hz <= fcMax &&
+        adp->lpf_hz != 0 && adp->lpf_hz <= ENV_BP_HI_HZ && adp->lpf_hz <= fcMax) {
+        flags |= ACQ_FLAG_ADP_ENV;
+    }
+    return flags;
+}
+
+// 连续多次请求合并为一次切换，延迟从最早的请求算起
+void Acq_RequestReconfig(uint16_t odr, uint8_t res8, const KX134_Adp_t *adp)
+{
+    taskENTER_CRITICAL();
+    if (!s_AcqReconf.pending) {
+        s_AcqReconf.odr = 0;
+        s_AcqReconf.res8 = ACQ_RECONF_KEEP;
+        s_AcqReconf.adpSet = 0;
+        s_AcqReconf.reqCyc = DWT->CYCCNT;
+    }
+    if (odr != 0) s_AcqReconf.odr = odr;
+    if (res8 != ACQ_RECONF_KEEP) s_AcqReconf.res8 = res8;
+    if (adp != NULL) {
+        s_AcqReconf.adp = *adp;
+        s_AcqReconf.adpSet = 1;
+    }
+    s_AcqReconf.pending = 1;
+    taskEXIT_CRITICAL();
+    xTaskNotifyGive(DataTaskHandle);   // 传感器没有中断 (如 ODR 极低) 时也能及时切换
+}
+
+// DataTask: 执行挂起的切换。KX134 在一次待机内改 ODR/分辨率并清空 FIFO，返回 1 表示已切换
+static uint8_t Acq_ApplyReconfig(void)
+{
+    if (!s_AcqReconf.pending) return 0;
+
+    taskENTER_CRITICAL();
+    uint16_t odr = s_AcqReconf.odr ? s_AcqReconf.odr : g_cfg_freq_hz;
+    uint8_t res8 = (s_AcqReconf.res8 != ACQ_RECONF_KEEP) ? s_AcqReconf.res8 : g_cfg_res8;
+    KX134_Adp_t adp = s_AcqReconf.adpSet ? s_AcqReconf.adp : g_cfg_adp;
+    uint32_t reqCyc = s_AcqReconf.reqCyc;
+    s_AcqReconf.pending = 0;
+    taskEXIT_CRITICAL();
+
+    KX134_Reconfigure(odr, res8, &adp);   // ADP 系数随 ODR 重算
+    g_cfg_freq_hz = odr;               // 采集配置只由 DataTask 改写
+    g_cfg_res8 = res8;
+    g_cfg_adp = adp;
+    s_AcqStats.reconfigs++;
+    s_AcqStats.reconfUs = (DWT->CYCCNT - reqCyc) / (SystemCoreClock / 1000000U);
+    return 1;
+}
+
+uint8_t LRec_Start(uint8_t axis, uint8_t decim, uint8_t pack8, uint32_t points)
+{
+    uint32_t cap = pack8 ? LREC_WORDS * 2 : LREC_WORDS;
+    if (axis >= AXIS_COUNT || decim == 0 || decim > LREC_DECIM_MAX || pack8 > 1 || points > cap) return 0;
+
+    uint8_t ok = 0;
+    taskENTER_CRITICAL();
+    if (s_LRec.state == LREC_STATE_IDLE || s_LRec.state == LREC_STATE_DONE) {
+        s_LRec.axis = axis;
+        s_LRec.decim = decim;
+        s_LRec.pack8 = pack8;
+        s_LRec.target = points ? points : cap;
+        s_LRec.count = 0;
+        s_LRec.state = LREC_STATE_ARMED;
+        ok = 1;
+    }
+    taskEXIT_CRITICAL();
+    return ok;
+}
+
+void LRec_Release(void)
+{
+    taskENTER_CRITICAL();
+    s_LRec.state = LREC_STATE_IDLE;   // DataTask 下次唤醒时归还帧缓冲池
+    taskEXIT_CRITICAL();
+}
+
+void LRec_GetInfo(LRecInfo_t *info)
+{
+    taskENTER_CRITICAL();
+    *info = s_LRec;
+    taskEXIT_CRITICAL();
+}
+
+uint16_t LRec_Read(float *out, uint32_t from, uint16_t n)
+{
+    const int16_t *rec16 = &g_SensorRawBuffer[0][0];
+    const int8_t  *rec8 = (const int8_t *)rec16;
+
+    if (s_LRec.state != LREC_STATE_DONE || from >= s_LRec.count) return 0;
+    if (n > s_LRec.count - from) n = (uint16_t)(s_LRec.count - from);
+    for (uint16_t i = 0; i < n; i++) {
+        int32_t v = s_LRec.pack8 ? ((int32_t)rec8[from + i] << 8) : rec16[from + i];
+        out[i] = (float)v * KX134_SENSITIVITY;
+    }
+    return n;
+}
+
+// DataTask: 开始 (或因采样率改变重新开始) 记录
+static void LRec_Begin(void)
+{
+    s_LRec.count = 0;
+    s_LRec.flags = Acq_ConfigFlags();
+    s_LRec.odr = g_cfg_freq_hz;
+    s_LRec.firstSample = s_AcqStats.samples;
+    s_LRec.tickStart = xTaskGetTickCount();
+    s_LRecAcc = 0;
+    s_LRecAccN = 0;
+    taskENTER_CRITICAL();
+    if (s_LRec.state == LREC_STATE_ARMED) s_LRec.state = LREC_STATE_RUN;
+    taskEXIT_CRITICAL();
+}
+
+// DataTask: 抽取后写入线性缓冲，写满 target 即冻结
+static void LRec_Store(const int16_t *src, uint32_t n)
+{
+    int16_t *rec16 = &g_SensorRawBuffer[0][0];
+    int8_t  *rec8 = (int8_t *)rec16;
+    uint32_t count = s_LRec.count;
+
+    for (uint32_t i = 0; i < n; i++) {
+        s_LRecAcc += src[i];
+        if (++s_LRecAccN < s_LRec.decim) continue;
+        int32_t v = s_LRecAcc / (int32_t)s_LRec.decim;
+        s_LRecAcc = 0;
+        s_LRecAccN = 0;
+        if (s_LRec.pack8) rec8[count] = (int8_t)(v >> 8);
+        else rec16[count] = (int16_t)v;
+        if (++count >= s_LRec.target) {
+            s_LRec.tickEnd = xTaskGetTickCount();
+            taskENTER_CRITICAL();
+            s_LRec.count = count;
+            if (s_LRec.state == LREC_STATE_RUN) s_LRec.state = LREC_STATE_DONE;
+            taskEXIT_CRITICAL();
+            return;
+        }
+    }
+    s_LRec.count = count;
+}
+
+// DataTask: 长记录期间代替正常的 FIFO 读取。记录完成后只清空 FIFO，保持水位中断持续产生
+static void LRec_Drain(void)
+{
+    if (s_LRec.state != LREC_STATE_RUN) {
+        KX134_FIFO_Clear();
+        return;
+    }
+
+    int16_t *scratch = &g_SensorRawBuffer[0][0] + LREC_WORDS;
+    uint16_t avail = KX134_FIFO_Samples();
+    if (avail == 0) return;
+    if (avail >= KX134_FIFO_Capacity()) {
+        s_AcqStats.overruns++;
+        s_AcqStats.gaps++;
+        s_LRec.flags |= ACQ_FLAG_OVERRUN;
+    }
+
+    KX134_Read_FIFO_DMA(scratch, KX134_FIFO_MAX_SAMPLES_8BIT, avail);
+    if (xSemaphoreTake(DmaCpltSem, 10) != pdTRUE) {
+        KX134_FIFO_Abort();
+        s_AcqStats.lostSamples += avail;
+        s_AcqStats.timeouts++;
+        s_AcqStats.gaps++;
+        s_LRec.flags |= ACQ_FLAG_TIMEOUT;
+        return;
+    }
+    s_AcqStats.samples += avail;
+    LRec_Store(scratch + (uint32_t)s_LRec.axis * KX134_FIFO_MAX_SAMPLES_8BIT, avail);   // 暂存区按轴分平面，间距 171
+}
+
 void DataTask_Entry(void *argument) 
 {
   if (KX134_Init()) {
-    KX134_SetODR(g_cfg_freq_hz);
+    KX134_Reconfigure(g_cfg_freq_hz, g_cfg_res8, &g_cfg_adp);
   }
 	memset(g_SensorRawBuffer, 0, sizeof(g_SensorRawBuffer));
 //	uint8_t check_cntl2 = KX134_ReadReg(0x1C);
   uint16_t buffer_offset = 0;// 记录当前填到 Buffer 的哪个位置了 (0 ~ 4096)
+  uint8_t write_slot = 0;      // 当前写入的帧槽位 (DataTask 独占)
+  uint32_t lastStatusCyc = DWT->CYCCNT;
+  uint8_t pendFlags = 0;       // 已发生、尚未记入帧的异常 (记入下一块所在帧)
+  uint8_t lrecOwned = 0;       // 1 = 帧缓冲池已全部收回用于长记录
     for(;;) {
       ulTaskNotifyTake(pdTRUE, portMAX_DELAY);// Notification 等待EXTI 中断
-      if (g_ResetAcqReq == 1) {
-            // 收到重置命令?
-            buffer_offset = 0;              // 指针归零，丢弃这?包数?
-            g_ResetAcqReq = 0;              // 清除标志           
-            memset(g_SensorRawBuffer[g_PingPongMgr.write_index], 0, sizeof(g_SensorRawBuffer[0]));
-            continue; 
+      // 配置切换: 在块边界执行，未采满的帧前后配置不一致，丢弃
+      if (Acq_ApplyReconfig()) {
+        buffer_offset = 0;
+        pendFlags = ACQ_FLAG_RECONF;   // 切换后的第一帧
+        lastStatusCyc = DWT->CYCCNT;
+        Trig_Reset();
+#if ALGO_STREAM_TIMEDOMAIN
+        Stream_Reset();
+#endif
+#if ALGO_WELCH_PSD
+        Welch_Reset();
+#endif
+        if (lrecOwned) {
+          // 长记录中改了采样率/分辨率: 从头记录；已完成的记录不动
+          if (s_LRec.state == LREC_STATE_RUN) {
+            s_LRec.state = LREC_STATE_ARMED;
+            LRec_Begin();
+          }
+        } else {
+          memset(g_SensorRawBuffer[write_slot], 0, sizeof(g_SensorRawBuffer[0]));
+        }
+        continue;
+      }
+      // 长记录: 收回 / 归还帧缓冲池
+      if (s_LRec.state == LREC_STATE_ARMED) {
+        if (!lrecOwned) FramePool_Reclaim();   // AlgoTask 拿不到新帧，分析暂停
+        lrecOwned = 1;
+        KX134_FIFO_Clear();
+        LRec_Begin();
+        continue;
+      }
+      if (lrecOwned) {
+        if (s_LRec.state != LREC_STATE_IDLE) {
+          LRec_Drain();
+          continue;
         }
-      uint8_t *p_target = (uint8_t*)&g_SensorRawBuffer[g_PingPongMgr.write_index][0];
-      p_target += (buffer_offset * 6); // 偏移多少字节 
+        lrecOwned = 0;
+        write_slot = FramePool_Restore();
+        buffer_offset = 0;
+        pendFlags = 0;
+#if ALGO_STREAM_TIMEDOMAIN
+        Stream_Reset();
+#endif
+#if ALGO_WELCH_PSD
+        Welch_Reset();
+#endif
+        Trig_Reset();
+        KX134_FIFO_Clear();
+        lastStatusCyc = DWT->CYCCNT;
+        continue;
+      }
+      // 按 BUF_STATUS 一次读完缓冲区中现有的采样；任务被延迟时不丢数据，直到缓冲区满
+      uint32_t statusCyc = DWT->CYCCNT;
+      uint16_t avail = KX134_FIFO_Samples();
+      if (avail >= KX134_FIFO_Capacity()) {
+        // 已满: 最旧的采样已被覆盖，按名义 ODR 估计丢失数
+        uint32_t expect = (uint32_t)((float)(statusCyc - lastStatusCyc) * (float)g_cfg_freq_hz / (float)SystemCoreClock);
+        if (expect > avail) s_AcqStats.lostSamples += expect - avail;
+        s_AcqStats.overruns++;
+        s_AcqStats.gaps++;
+        pendFlags |= ACQ_FLAG_OVERRUN;
+        Trig_MarkGap(ACQ_FLAG_OVERRUN);
+#if ALGO_WELCH_PSD
+        Welch_MarkGap();
+#endif
+      }
+      lastStatusCyc = statusCyc;
 
-      KX134_Read_FIFO_DMA(p_target);
-      if (xSemaphoreTake(DmaCpltSem, 10) == pdTRUE) 
+      while (avail > 0)
       {
-        buffer_offset += FIFO_WATERMARK;
+        uint8_t slot = write_slot;
+        uint16_t n = avail;
+        if (n > FFT_POINTS - buffer_offset) n = FFT_POINTS - buffer_offset;   // 不跨越帧
+        int16_t *pFrame = g_SensorRawBuffer[slot];
+
+        KX134_Read_FIFO_DMA(&pFrame[buffer_offset], FFT_POINTS, n);   // 完成中断里按轴拆分到三个平面
+        if (xSemaphoreTake(DmaCpltSem, 10) != pdTRUE)
+        {
+          // 超时: SPI DMA 卡死，终止传输并清空 FIFO (已读出部分采样，字节对齐不可信)。
+          // 清空后本块与本次状态中其余未读的采样 (共 avail 个) 都已不在 FIFO 中，
+          // 另加状态读之后新到的 (按名义 ODR 估计)。缺口记入下一块所在的帧
+          KX134_FIFO_Abort();
+          uint32_t clearCyc = DWT->CYCCNT;
+          uint32_t arrived = (uint32_t)((float)(clearCyc - statusCyc) * (float)g_cfg_freq_hz / (float)SystemCoreClock);
+          s_AcqStats.lostSamples += avail + arrived;
+          lastStatusCyc = clearCyc;
+          s_AcqStats.timeouts++;
+          s_AcqStats.gaps++;
+          pendFlags |= ACQ_FLAG_TIMEOUT;
+          Trig_MarkGap(ACQ_FLAG_TIMEOUT);
+#if ALGO_WELCH_PSD
+          Welch_MarkGap();
+#endif
+          break;
+        }
+        if (buffer_offset == 0) Acq_FrameStart(slot);   // 帧的第一块读成功后才开始计帧 (seq/firstSample)
+        s_AcqFrame[slot].flags |= pendFlags;
+        pendFlags = 0;
+        Acq_BlockStamp(slot, statusCyc, buffer_offset, n);
+#if ALGO_STREAM_TIMEDOMAIN
+        // 刚搬完的块立即折算进时域累加量，削平 AlgoTask 的帧末尖峰
+        Stream_AccumulateBlock(pFrame, buffer_offset, n);
+#endif
+#if ALGO_WELCH_PSD
+        Welch_AccumulateBlock(pFrame, buffer_offset, n);
+#endif
+        Trig_ProcessBlock(pFrame, buffer_offset, n, s_AcqStats.samples - n);   // 未布防时直接返回
+        buffer_offset += n;
+        avail -= n;
         if (buffer_offset >= FFT_POINTS) 
         {
-          g_PingPongMgr.read_index = g_PingPongMgr.write_index;
-          g_PingPongMgr.write_index = !g_PingPongMgr.write_index;
+          Acq_FrameFinish(slot);
+#if ALGO_STREAM_TIMEDOMAIN
+          Stream_FinishFrame(slot);
+#endif
+#if ALGO_WELCH_PSD
+          Welch_FinishFrame(slot);
+#endif
+          write_slot = FramePool_Submit(slot);   // 交给 AlgoTask (就绪队列唤醒)
           buffer_offset = 0;
-          xTaskNotifyGive(AlgoTaskHandle);// 通知 AlgoTask
         }
       }
-      else {           
-            KX134_CS_High();// 超时处理：如??? SPI DMA 卡死了，记得在这里拉??? CS 复位 SPI
-        }
     }
 
 		//debug
@@ -241,18 +668,31 @@ void AlgoTask_Entry(void *argument)
 {
   Calc_Init();
     for(;;) {
-      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-      uint8_t process_idx = g_PingPongMgr.read_index;
+      uint8_t process_idx = FramePool_Take();
       int16_t *pSource = &g_SensorRawBuffer[process_idx][0];
-      Process_Data(pSource);
+      Calc_SetFrameConfig(s_AcqFrame[process_idx].odr, s_AcqFrame[process_idx].flags);   // 切换前采满的帧仍按原配置计算
+#if ALGO_STREAM_TIMEDOMAIN
+      Process_Data(pSource, Stream_GetFrame(process_idx));
+#else
+      Process_Data(pSource, NULL);
+#endif
+#if ALGO_WELCH_PSD
+      Welch_Publish(process_idx);
+#endif
+      FramePool_Release(process_idx);
     }
 }
 
 void CommTask_Entry(void *argument) 
 {
+    TickType_t wait = Protocol_Poll();   // 波特率试用期间限时等待，流式下载期间每 tick 推送
     for(;;) {
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-        Protocol_HandleRxFrame(g_UartRxBuffer, g_UartRxLen, LOCAL_DEVICE_ADDR);
+        uint16_t len;
+        const uint8_t *frame = UartRx_Receive(&len, wait);   // 中断已按长度/CRC 拆好的帧，连发时依次取出
+        if (frame) {
+            Protocol_HandleRxFrame(frame, len, LOCAL_DEVICE_ADDR);
+        }
+        wait = Protocol_Poll();
     }
 }
 /* USER CODE END Application */
@@ -49,18 +49,16 @@
 
 /* USER CODE BEGIN PV */
 
-// 原始数据乒乓缓冲 (4096 * 3 * 2 * 2 = 48KB)
-int16_t g_SensorRawBuffer[2][FFT_POINTS * AXIS_COUNT];
-PingPong_Mgr_t g_PingPongMgr = {0, 1, 0};
+// 原始数据帧缓冲池 (4096 * 3 * 2 * FRAME_POOL_SLOTS，2 槽 = 48KB)，所有权由 freertos.c 中的队列管理
+int16_t g_SensorRawBuffer[FRAME_POOL_SLOTS][FFT_POINTS * AXIS_COUNT];
 
-uint8_t rx_dma_buf[UART_RX_BUF_SIZE];  
-uint8_t g_UartRxBuffer[UART_RX_BUF_SIZE];
-volatile uint16_t g_UartRxLen = 0;//实际接收字节
 extern SemaphoreHandle_t DmaCpltSem;//DMA信号?
 
 uint8_t LOCAL_DEVICE_ADDR = FLASH_CFG_DEFAULT_ADDR;
 uint16_t g_cfg_freq_hz = FLASH_CFG_DEFAULT_FREQ;
-volatile uint8_t g_ResetAcqReq = 0; // 请求重置采集
+uint8_t  g_cfg_window = WIN_DEFAULT;        // 频谱窗函数 (WIN_xxx)
+uint8_t  g_cfg_res8 = 0;                    // 1 = KX134 8 位缓冲模式
+KX134_Adp_t g_cfg_adp = { KX134_ADP_OFF, 0, 0 };   // 传感器内滤波 (ADP)
 
 /* USER CODE END PV */
 
@@ -90,15 +88,29 @@ void App_ConfigInit()
     if(freq != 0xFFFF && freq != 0) {
         g_cfg_freq_hz = freq;
     }
+    uint8_t win = Flash_ReadWindow();
+    g_cfg_window = (win < WIN_TYPE_NUM) ? win : WIN_DEFAULT;
+    g_cfg_res8 = (Flash_ReadRes8() == 1) ? 1 : 0;   // 旧配置为 0xFF，按 16 位
+    Flash_ReadAdp(&g_cfg_adp);
+    if (g_cfg_adp.mode >= KX134_ADP_MODE_NUM || !KX134_ADP_ENABLE) g_cfg_adp.mode = KX134_ADP_OFF;   // 旧配置为 0xFF
+    Protocol_BaudBoot(Flash_ReadBaud());            // 非 9600 时进入试用，未确认则回落
 	
     //KX134_SetODR(g_cfg_freq_hz);
 }
 
-void Uart1_RxStart(void)
+// 改波特率: 停接收 -> 重新初始化 -> 恢复接收 (原来未开接收则不开)，调用前应确认发送已完成
+void Uart1_SetBaud(uint32_t baud)
 {
-    __HAL_UART_CLEAR_IDLEFLAG(&huart1);          // 清一次IDLE 残留 
-    __HAL_UART_ENABLE_IT(&huart1, UART_IT_IDLE);    
-    HAL_UART_Receive_DMA(&huart1, rx_dma_buf, UART_RX_BUF_SIZE);
+    uint8_t rx_on = (huart1.RxState != HAL_UART_STATE_READY);
+    HAL_NVIC_DisableIRQ(USART1_IRQn);
+    if (rx_on) HAL_UART_AbortReceive(&huart1);
+    huart1.Init.BaudRate = baud;
+    if (HAL_UART_Init(&huart1) != HAL_OK)
+    {
+        Error_Handler();
+    }
+    if (rx_on) UartRx_Start();
+    HAL_NVIC_EnableIRQ(USART1_IRQn);
 }
 
 /* USER CODE END 0 */
@@ -139,7 +151,8 @@ int main(void)
   MX_IWDG_Init();
   /* USER CODE BEGIN 2 */
   App_ConfigInit();
-  Uart1_RxStart();
+  UartRx_Init();
+  UartRx_Start();     // 循环 DMA 一直运行，调度器启动前收到的帧在队列中等 CommTask
   /* USER CODE END 2 */
 
   /* Init scheduler */
@@ -215,6 +228,7 @@ void SystemClock_Config(void)
 
 void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin) {
     if (GPIO_Pin == KX134_INT1_Pin) {
+        KX134_FIFO_IrqStamp();
         // 1. 唤醒 DataTask
         BaseType_t xHigherPriorityTaskWoken = pdFALSE;
         extern TaskHandle_t DataTaskHandle;
@@ -226,8 +240,8 @@ void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin) {
 void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef *hspi) 
 {
     if (hspi->Instance == SPI1) {
-        // 1. 拉高 CS
-        KX134_CS_High();
+        // 1. 拉高 CS (全双工模式下同时把数据搬入目标缓冲)
+        KX134_FIFO_DMA_Cplt();
         
         // 2. DataTask：DMA 搬完
         BaseType_t xHigherPriorityTaskWoken = pdFALSE;
@@ -236,11 +250,43 @@ void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef *hspi)
     }
 }
 
+// 全双工 FIFO 读取 (KX134_DRAIN_FULL_DUPLEX) 的完成回调，处理与只收相同
+void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+    HAL_SPI_RxCpltCallback(hspi);
+}
+
 void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
 {
     if (huart->Instance == USART1)
     {
-        g_tx_busy = 0; 
+        UartTx_TxCpltFromISR();   // 归还缓冲并直接启动队列中的下一帧
+    }
+}
+
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
+{
+    if (huart->Instance == USART1)
+    {
+        UartTx_ErrorFromISR();    // DMA 发送出错被中止时作废当前帧，继续发后面的
+        UartRx_ErrorFromISR();    // 接收错误使 HAL 停了接收 DMA 时重启
+    }
+}
+
+// 接收环半满/全满: 循环 DMA 不停，只取新到的字节拆帧
+void HAL_UART_RxHalfCpltCallback(UART_HandleTypeDef *huart)
+{
+    if (huart->Instance == USART1)
+    {
+        UartRx_DmaFromISR();
+    }
+}
+
+void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
+{
+    if (huart->Instance == USART1)
+    {
+        UartRx_DmaFromISR();
     }
 }
 
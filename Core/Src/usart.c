@@ -24,7 +24,6 @@
 #include "FreeRTOS.h"
 #include "task.h"
 #include "cmsis_os.h"  
-extern TaskHandle_t CommTaskHandle;
 /* USER CODE END 0 */
 
 UART_HandleTypeDef huart1;
@@ -165,23 +164,8 @@ void USAR_UART_IDLECallback(UART_HandleTypeDef *huart)
 {
 	if(huart->Instance == USART1)
 	{
-		HAL_UART_DMAStop(&huart1);  																									 
-		// 计算接收到的数据长度
-    uint16_t recv_len = UART_RX_BUF_SIZE - __HAL_DMA_GET_COUNTER(&hdma_usart1_rx);		
-    if (recv_len == 0) {// 上电/抖动导致        
-        Uart1_RxStart();            
-        return;
-    }
-		if (recv_len <= UART_RX_BUF_SIZE) 
-		{
-				memcpy(g_UartRxBuffer, rx_dma_buf, recv_len);  
-				g_UartRxLen   = recv_len;
-				BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-        vTaskNotifyGiveFromISR(CommTaskHandle, &xHigherPriorityTaskWoken);//发??知? CommTask
-        portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
-		}
+		UartRx_IdleFromISR();   // 一帧(或几帧)收完: 接收 DMA 不停，按写指针拆出完整帧放入帧队列
 	}
-	Uart1_RxStart();
 }
 
 void On_IDLE(UART_HandleTypeDef *huart)
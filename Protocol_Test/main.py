@@ -19,16 +19,40 @@ CONFIG = {
     'OTA_FILE': 'F411_VibrationSensor_RTOS.bin',  # OTA固件名
     'SAVE_DIR': 'wave_data',  # 波形保存路径
     'OTA_ERASE_TIME': 8.0,  # OTA擦除等待时间
-    'OTA_PACKET_SIZE': 256  # OTA包大小
+    'OTA_PACKET_SIZE': 256,  # OTA包大小
+    'WAVE_ENC': 0x02  # 波形编码 (WAVE_ENC_xxx)
 }
 
 # --- 协议命令码 ---
 CMD_FEATURE = 0x02  # 特征值请求
 CMD_WAVE = 0x04  # 波形请求 (Snapshot)
 CMD_WAVE_PACK = 0x03  # 波形包读取
+CMD_PEAKS = 0x05  # 频谱峰值表
+CMD_PSD = 0x06  # Welch 功率谱结果
+CMD_ACQ_INFO = 0x07  # 采集帧完整性/时间戳
+CMD_TRIG_INFO = 0x08  # 触发捕获状态
+CMD_TRIG_PACK = 0x09  # 触发捕获数据包
+CMD_LREC = 0x0A  # 长记录控制/状态
+CMD_LREC_PACK = 0x0B  # 长记录数据包 (16 位包序号)
+CMD_WAVE_STREAM = 0x0C  # 波形快照流式下载
+WAVE_STREAM_ALL, WAVE_STREAM_BITMAP = 0x00, 0x01
+WAVE_ENC_F32, WAVE_ENC_I16, WAVE_ENC_DELTA = 0x00, 0x01, 0x02  # 波形包编码
+WAVE_ENC_NAMES = {WAVE_ENC_F32: 'F32', WAVE_ENC_I16: 'I16', WAVE_ENC_DELTA: 'DELTA'}
+WAVE_RICE_ESC = 16  # DELTA 编码 Rice 转义前缀长度
+CMD_BAUD = 0x0D  # 串口波特率协商
+BAUD_TABLE = [9600, 19200, 38400, 57600, 115200, 230400, 460800, 921600]  # 下标即波特率编号
+BAUD_QUERY = 0xFF
+BAUD_PROBATION_S = 3.0  # 设备等待确认帧的时间，超时回落到 9600
+CMD_TX_STATS = 0x0E  # 串口发送队列统计
+CMD_XY_PEAKS = 0x0F  # X/Y 轴频谱主峰
+LREC_QUERY, LREC_START, LREC_RELEASE = 0x00, 0x01, 0x02
 CMD_DISCOVER = 0x41  # 发现设备/读取UID
 CMD_SET_ADDR = 0x42  # 设置设备地址 (广播+UID匹配)
 CMD_CONFIG = 0x87  # 设置频率
+CFG_SUB_WINDOW = 0x03  # CMD_CONFIG 子命令: 窗函数
+CFG_SUB_RESOLUTION = 0x04  # CMD_CONFIG 子命令: 采集分辨率
+CFG_SUB_TRIGGER = 0x05  # CMD_CONFIG 子命令: 触发捕获
+CFG_SUB_ADP = 0x06  # CMD_CONFIG 子命令: 传感器内滤波 (ADP)
 CMD_OTA_START = 0x50  # OTA 开始
 CMD_OTA_DATA = 0x51  # OTA 数据
 CMD_OTA_END = 0x52  # OTA 结束
@@ -76,6 +100,116 @@ def open_serial():
         return None
 
 
+def rice_decode(data, n, k):
+    """解 n 个 Rice 码 (WAVE_ENC_DELTA)，返回差分值列表"""
+    bits = ''.join(f'{b:08b}' for b in data)
+    pos = 0
+    out = []
+    for _ in range(n):
+        q = 0
+        while q < WAVE_RICE_ESC and bits[pos] == '1':
+            q += 1
+            pos += 1
+        if q == WAVE_RICE_ESC:  # 转义: 17 位原值
+            u = int(bits[pos:pos + 17], 2)
+            pos += 17
+        else:
+            pos += 1
+            u = (q << k) | (int(bits[pos:pos + k], 2) if k else 0)
+            pos += k
+        out.append((u >> 1) ^ -(u & 1))
+    return out
+
+
+def decode_wave_pkt(frame, pts_per_pkt, f32):
+    """解波形包数据区 (已校验 CRC)，返回 g 值数组；格式见 docs/protocol.md CMD_WAVE_PACK"""
+    if f32:
+        return np.frombuffer(frame[4:-2], dtype='>f4')
+    enc = frame[4]
+    scale, offset = struct.unpack('>ff', frame[6:14])
+    if enc == WAVE_ENC_I16:
+        x = np.frombuffer(frame[14:14 + pts_per_pkt * 2], dtype='>i2').astype(np.float64)
+    elif enc == WAVE_ENC_DELTA:
+        k, shift = frame[14], frame[15]
+        x0 = struct.unpack('>h', frame[16:18])[0]
+        d = rice_decode(frame[18:-2], pts_per_pkt - 1, k)
+        x = np.cumsum([x0] + d).astype(np.float64) * (1 << shift)
+    else:
+        return None
+    return ((x - offset) * scale).astype(np.float32)
+
+
+def parse_wave_pkts(buf, cmd, total_pkts, pts_per_pkt, f32, got):
+    """按帧头 + CRC 从缓冲区提取波形包 (丢字节只影响所在的包)，存入 got，返回未消耗的尾部"""
+    i = 0
+    while len(buf) - i >= 6:
+        if (buf[i] != CONFIG['ADDR'] or buf[i + 1] != cmd or buf[i + 2] >= total_pkts
+                or buf[i + 3] != total_pkts):
+            i += 1
+            continue
+        n = 4 + pts_per_pkt * 4 + 2 if f32 else 6 + buf[i + 5] + 2
+        if len(buf) - i < n:
+            break
+        frame = buf[i:i + n]
+        if calc_crc16(frame[:-2]) == struct.unpack('<H', frame[-2:])[0]:
+            data = decode_wave_pkt(frame, pts_per_pkt, f32)
+            if data is not None:
+                got[frame[2]] = data
+                i += n
+                print(f"\r 进度: {len(got)}/{total_pkts}", end='')
+                continue
+        i += 1
+    return buf[i:]
+
+
+def wave_stream_download(ser, total_pkts, pts_per_pkt, enc=None, max_rounds=4):
+    """
+    流式下载波形快照: 一次请求，设备背靠背推送全部包 (CMD_WAVE_STREAM)，
+    按序号与 CRC 收包，缺失/损坏的包用位图请求补发。返回 (各包 g 值数组字典, 收到字节数, 耗时)
+    enc 为 WAVE_ENC_xxx (默认 CONFIG['WAVE_ENC'])，I16/DELTA 包长可变
+    """
+    if enc is None:
+        enc = CONFIG['WAVE_ENC']
+    f32 = (enc == WAVE_ENC_F32)
+    f32_len = 4 + pts_per_pkt * 4 + 2
+    got = {}
+    wire_bytes = 0
+    old_timeout = ser.timeout
+    start = time.time()
+    try:
+        ser.timeout = 0.05
+        for rnd in range(max_rounds):
+            missing = [q for q in range(total_pkts) if q not in got]
+            if not missing:
+                break
+            if rnd == 0:
+                payload = struct.pack('BBB', WAVE_STREAM_ALL, enc, 0)
+            else:
+                bitmap = bytearray(total_pkts // 8)
+                for q in missing:
+                    bitmap[q >> 3] |= 1 << (q & 7)
+                payload = struct.pack('B', WAVE_STREAM_BITMAP) + bytes(bitmap) + struct.pack('B', enc)
+                print(f"\n 补发 {len(missing)} 包...")
+
+            # 最长等待按 F32 包长与波特率估算 (留 50% 余量)，收齐或线路空闲 0.3s 即结束本轮
+            deadline = time.time() + len(missing) * f32_len * 10 / CONFIG['BAUD'] * 1.5 + 1.0
+            ser.write(build_frame(CONFIG['ADDR'], CMD_WAVE_STREAM, payload))
+            buf = b''
+            last_rx = time.time()
+            while len(got) < total_pkts and time.time() < deadline:
+                chunk = ser.read(max(1, ser.in_waiting))
+                if chunk:
+                    buf += chunk
+                    wire_bytes += len(chunk)
+                    last_rx = time.time()
+                    buf = parse_wave_pkts(buf, CMD_WAVE_STREAM, total_pkts, pts_per_pkt, f32, got)
+                elif wire_bytes and time.time() - last_rx > 0.3:
+                    break
+    finally:
+        ser.timeout = old_timeout
+    return got, wire_bytes, time.time() - start
+
+
 def parse_packet_from_buffer(buffer):
     """
     从缓冲区尝试解析一个完整帧 (固定长度18字节)
@@ -298,18 +432,87 @@ def task_set_frequency():
         ser.close()
 
 
+def task_set_window():
+    print("\n--- 设置 FFT 窗函数 ---")
+    print("0. 矩形窗 (不加窗)")
+    print("1. Hann (默认)")
+    print("2. Hamming")
+    print("3. 平顶窗 (幅值最准)")
+    print("4. Blackman-Harris")
+
+    sel = input("请选择窗函数 [0-4]: ").strip()
+    if sel not in ('0', '1', '2', '3', '4'):
+        print("无效选择")
+        return
+
+    ser = open_serial()
+    if not ser: return
+
+    try:
+        # Payload: [WINDOW 子命令 03] + [窗编号] + [Pad 00]
+        payload = struct.pack('BBB', CFG_SUB_WINDOW, int(sel), 0x00)
+        frame = build_frame(CONFIG['ADDR'], CMD_CONFIG, payload)
+        ser.write(frame)
+
+        ack = ser.read(7)
+        if len(ack) == 7 and ack[1] == CMD_CONFIG and ack[3] == 0x4F and ack[4] == 0x4B:
+            print("[成功] 窗函数已设置 (下一帧生效)")
+        elif len(ack) == 7:
+            print(f"[失败] 收到异常响应: {ack.hex()}")
+        else:
+            print("[失败] 等待响应超时")
+
+    except Exception as e:
+        print(f"运行时错误: {e}")
+    finally:
+        ser.close()
+
+
+def task_set_resolution():
+    print("\n--- 设置采集分辨率 ---")
+    print("0. 16 位 (默认)")
+    print("1. 8 位 (FIFO 深度加倍，适合高采样率)")
+
+    sel = input("请选择分辨率 [0-1]: ").strip()
+    if sel not in ('0', '1'):
+        print("无效选择")
+        return
+
+    ser = open_serial()
+    if not ser: return
+
+    try:
+        # Payload: [RESOLUTION 子命令 04] + [0/1] + [Pad 00]
+        payload = struct.pack('BBB', CFG_SUB_RESOLUTION, int(sel), 0x00)
+        frame = build_frame(CONFIG['ADDR'], CMD_CONFIG, payload)
+        ser.write(frame)
+
+        ack = ser.read(7)
+        if len(ack) == 7 and ack[1] == CMD_CONFIG and ack[3] == 0x4F and ack[4] == 0x4B:
+            print("[成功] 分辨率已设置 (采集已重启)")
+        elif len(ack) == 7:
+            print(f"[失败] 收到异常响应: {ack.hex()}")
+        else:
+            print("[失败] 等待响应超时")
+
+    except Exception as e:
+        print(f"运行时错误: {e}")
+    finally:
+        ser.close()
+
+
 # ==========================================
 # [功能] 4. 读取特征值与波形
 # ==========================================
 
 def parse_features_and_print(raw_data):
     """解析特征值包"""
-    if len(raw_data) != 77:
-        print(f" 特征值包长度错误: {len(raw_data)} (预期 77)")
+    if len(raw_data) != 109:
+        print(f" 特征值包长度错误: {len(raw_data)} (预期 109)")
         return False
 
     payload = raw_data[3:-2]
-    floats = struct.unpack('>18f', payload)
+    floats = struct.unpack('>26f', payload)
 
     print("\n" + "=" * 40)
     print(f"传感器特征值报告 (设备 0x{raw_data[0]:02X})")
@@ -319,6 +522,12 @@ def parse_features_and_print(raw_data):
     print(f"[Z 轴] Mean:{floats[8]:.4f}g, RMS:{floats[9]:.4f}mm/s, P-P:{floats[10]:.4f}g, Kurt:{floats[11]:.4f}")
     print(f"       主频:{floats[12]:.1f}Hz, 幅值:{floats[13]:.4f}g")
     print(f"       包络RMS:{floats[15]:.4f}g, 包络峰值:{floats[16]:.4f}g")
+    print(f"       速度RMS(10~1000Hz):{floats[18]:.4f}mm/s, 位移峰峰值:{floats[19]:.2f}um")
+    if floats[20] < 0:
+        env = "不可用 (定点模式)"
+    else:
+        env = ", ".join(f"{floats[20 + 2 * n]:.2f}Hz/{floats[21 + 2 * n]:.4f}g" for n in range(3))
+    print(f"       包络谱峰值: {env}")
     print(f"[其他] 温度:{floats[17]:.2f}")
     print("=" * 40 + "\n")
     return True
@@ -337,8 +546,8 @@ def task_read_sensor():
         payload = struct.pack('BBB', 0, 0, 0)
         ser.write(build_frame(CONFIG['ADDR'], CMD_FEATURE, payload))
 
-        feat_resp = ser.read(77)
-        if len(feat_resp) == 77:
+        feat_resp = ser.read(109)
+        if len(feat_resp) == 109:
             parse_features_and_print(feat_resp)
         else:
             print(f"特征值读取失败 (Len={len(feat_resp)})")
@@ -360,24 +569,18 @@ def task_read_sensor():
         total_pkts = TOTAL_POINTS // PTS_PER_PKT
         all_data = []
 
-        print(f"[3/3] 开始读取波形 ({TOTAL_POINTS}点)...")
-        start_time = time.time()
-        expected_len = 4 + (PTS_PER_PKT * 4) + 2
-
-        for seq in range(total_pkts):
-            payload = struct.pack('BB B', seq, total_pkts, 0x00)
-            ser.write(build_frame(CONFIG['ADDR'], CMD_WAVE_PACK, payload))
-
-            resp = ser.read(expected_len)
-            if len(resp) != expected_len:
-                print(f"\n 包 {seq} 丢失 (Len={len(resp)})")
-                break
-
-            floats = np.frombuffer(resp[4:-2], dtype='>f4')
-            all_data.extend(floats)
-            print(f"\r 进度: {seq + 1}/{total_pkts}", end='')
+        print(f"[3/3] 开始读取波形 ({TOTAL_POINTS}点，流式)...")
+        got, wire_bytes, elapsed = wave_stream_download(ser, total_pkts, PTS_PER_PKT)
+        if len(got) == total_pkts:
+            for seq in range(total_pkts):
+                all_data.extend(got[seq])
+        else:
+            print(f"\n 仍缺 {total_pkts - len(got)} 包，放弃")
 
-        print(f"\n 读取完成，耗时 {time.time() - start_time:.2f}s")
+        line_time = wire_bytes * 10 / CONFIG['BAUD']
+        f32_bytes = total_pkts * (4 + PTS_PER_PKT * 4 + 2)
+        print(f"\n 读取完成，耗时 {elapsed:.2f}s，线路占用率 {line_time / elapsed * 100 if elapsed else 0:.0f}%，"
+              f"编码 {WAVE_ENC_NAMES.get(CONFIG['WAVE_ENC'], '?')} {wire_bytes} 字节 (F32 的 1/{f32_bytes / wire_bytes if wire_bytes else 0:.2f})")
 
         if len(all_data) > 0:
             timestamp = datetime.now().strftime("%Y%m%d_%H%M%S")
@@ -401,6 +604,436 @@ def task_read_sensor():
         ser.close()
 
 
+def task_read_peaks():
+    """读取 Z 轴频谱峰值表 (不必拉取整段波形)"""
+    PEAK_N = 8
+    frame_len = 3 + 1 + PEAK_N * 10 + 2
+    tag_name = {0: '', 1: '基频', 2: '谐波', 3: '边带'}
+
+    ser = open_serial()
+    if not ser: return
+    try:
+        ser.write(build_frame(CONFIG['ADDR'], CMD_PEAKS, struct.pack('BBB', 0, 0, 0)))
+        resp = ser.read(frame_len)
+        if len(resp) != frame_len or resp[1] != CMD_PEAKS:
+            print(f"峰值表读取失败 (Len={len(resp)})")
+            return
+        if calc_crc16(resp[:-2]) != struct.unpack('<H', resp[-2:])[0]:
+            print("峰值表 CRC 错误")
+            return
+
+        count = resp[3]
+        if count == 0xFF:
+            print("峰值表不可用 (定点模式)")
+            return
+        print(f"\nZ 轴频谱峰值表 ({count} 个)")
+        for i in range(count):
+            freq, amp, tag, ref = struct.unpack('>ffBB', resp[4 + i * 10: 14 + i * 10])
+            rel = f"{tag_name.get(tag, '?')} (#{ref})" if tag in (2, 3) else tag_name.get(tag, '?')
+            print(f"  #{i}  {freq:9.2f} Hz  {amp:.4f} g  {rel}")
+    finally:
+        ser.close()
+
+
+def task_read_psd():
+    """读取 Z 轴 Welch 平均功率谱结果 (主峰 + 频带能量)"""
+    BAND_EDGES = [10, 100, 250, 500, 1000, 2000, 4000, 8000, 12800]
+    band_n = len(BAND_EDGES) - 1
+    frame_len = 3 + 2 + (4 + band_n) * 4 + 2
+
+    ser = open_serial()
+    if not ser: return
+    try:
+        ser.write(build_frame(CONFIG['ADDR'], CMD_PSD, struct.pack('BBB', 0, 0, 0)))
+        resp = ser.read(frame_len)
+        if len(resp) != frame_len or resp[1] != CMD_PSD:
+            print(f"功率谱读取失败 (Len={len(resp)})")
+            return
+        if calc_crc16(resp[:-2]) != struct.unpack('<H', resp[-2:])[0]:
+            print("功率谱 CRC 错误")
+            return
+
+        segs = struct.unpack('>H', resp[3:5])[0]
+        vals = struct.unpack(f'>{4 + band_n}f', resp[5:-2])
+        if segs == 0xFFFF:
+            print("Welch 不可用 (定点模式)")
+            return
+        if segs == 0:
+            print("Welch 结果无效 (尚未凑满一段)")
+            return
+        print(f"\nZ 轴 Welch 功率谱 (平均 {segs} 段)")
+        print(f"  主峰 {vals[0]:9.2f} Hz  {vals[1]:.4f} g   2x {vals[2]:.4f} g   RMS {vals[3]:.4f} g")
+        for i in range(band_n):
+            e = vals[4 + i]
+            if e < 0:
+                print(f"  {BAND_EDGES[i]:>5} ~ {BAND_EDGES[i + 1]:<5} Hz  (高于 ODR/2)")
+                continue
+            print(f"  {BAND_EDGES[i]:>5} ~ {BAND_EDGES[i + 1]:<5} Hz  {e:.3e} g²  ({np.sqrt(e):.4f} g rms)")
+    finally:
+        ser.close()
+
+
+def task_read_acq_info():
+    """读取最近完成帧的完整性标志、实测 ODR 与累计丢包统计"""
+    frame_len = 3 + 55 + 2
+
+    ser = open_serial()
+    if not ser: return
+    try:
+        ser.write(build_frame(CONFIG['ADDR'], CMD_ACQ_INFO, struct.pack('BBB', 0, 0, 0)))
+        resp = ser.read(frame_len)
+        if len(resp) != frame_len or resp[1] != CMD_ACQ_INFO:
+            print(f"采集信息读取失败 (Len={len(resp)})")
+            return
+        if calc_crc16(resp[:-2]) != struct.unpack('<H', resp[-2:])[0]:
+            print("采集信息 CRC 错误")
+            return
+
+        seq, first, tick, odr, blocks, flags = struct.unpack('>IIIfHB', resp[3:22])
+        samples, overruns, timeouts, gaps, lost, bad, dropped, reconfs, reconf_us = struct.unpack('>9I', resp[22:58])
+        names = [n for b, n in ((0x01, 'FIFO溢出'), (0x02, 'DMA超时'), (0x04, '时间戳记录满'), (0x08, '8位分辨率'), (0x10, '配置切换后首帧'),
+                                 (0x20, 'ADP滤波'), (0x40, 'ADP包络带通'), (0x80, 'ADP RMS')) if flags & b]
+        print(f"\n最近帧 #{seq}: 首采样 {first}, tick {tick}, {blocks} 块, 实测 ODR {odr:.1f} Hz")
+        print(f"  完整性: {'正常' if (flags & 0x03) == 0 else '数据不连续'} {' '.join(names)}")
+        print(f"  累计: 采样 {samples}, 溢出 {overruns}, 超时 {timeouts}, 不连续 {gaps}, "
+              f"估计丢失 {lost} 点, 坏帧 {bad}, 算法来不及处理丢帧 {dropped}")
+        if reconfs:
+            print(f"  配置切换 {reconfs} 次, 最近一次耗时 {reconf_us / 1000:.1f} ms")
+    finally:
+        ser.close()
+
+
+def task_read_tx_stats():
+    """读取设备串口发送队列的累计统计 (缓冲池反压情况)"""
+    frame_len = 3 + 26 + 2
+
+    ser = open_serial()
+    if not ser: return
+    try:
+        ser.write(build_frame(CONFIG['ADDR'], CMD_TX_STATS, struct.pack('BBB', 0, 0, 0)))
+        resp = ser.read(frame_len)
+        if len(resp) != frame_len or resp[1] != CMD_TX_STATS:
+            print(f"发送统计读取失败 (Len={len(resp)})")
+            return
+        if calc_crc16(resp[:-2]) != struct.unpack('<H', resp[-2:])[0]:
+            print("发送统计 CRC 错误")
+            return
+
+        submitted, sent, nbytes, waits, fails, dma_err, free_min, queued_max = struct.unpack('>6IBB', resp[3:29])
+        print(f"\n提交 {submitted} 帧, 发完 {sent} 帧 / {nbytes} 字节, DMA 错误 {dma_err}")
+        print(f"  缓冲池: 等待 {waits} 次, 超时丢弃 {fails} 帧, 空闲最少 {free_min}, 排队最多 {queued_max}")
+        if fails:
+            print("  [提示] 有应答因缓冲池用尽被丢弃")
+    finally:
+        ser.close()
+
+
+def task_read_xy_peaks():
+    """读取 X/Y 轴频谱主峰 (只搜索 0.1875 × ODR 以下)"""
+    frame_len = 3 + 24 + 2
+
+    ser = open_serial()
+    if not ser: return
+    try:
+        ser.write(build_frame(CONFIG['ADDR'], CMD_XY_PEAKS, struct.pack('BBB', 0, 0, 0)))
+        resp = ser.read(frame_len)
+        if len(resp) != frame_len or resp[1] != CMD_XY_PEAKS:
+            print(f"X/Y 主峰读取失败 (Len={len(resp)})")
+            return
+        if calc_crc16(resp[:-2]) != struct.unpack('<H', resp[-2:])[0]:
+            print("X/Y 主峰 CRC 错误")
+            return
+
+        vals = struct.unpack('>6f', resp[3:27])
+        if vals[0] < 0:
+            print("X/Y 主峰不可用 (定点模式)")
+            return
+        for name, (freq, amp, amp2x) in (('X', vals[0:3]), ('Y', vals[3:6])):
+            if freq == 0:
+                print(f"[{name}] 无高于噪声底的峰")
+                continue
+            print(f"[{name}] 主峰 {freq:9.2f} Hz  {amp:.4f} g   2x {amp2x:.4f} g")
+    finally:
+        ser.close()
+
+
+def task_set_adp():
+    """设置 KX134 高级数据通路 (传感器内带通 / RMS)，开启后所有数据均为滤波结果"""
+    print("\n--- 传感器内滤波 (ADP) ---")
+    print("0. 关闭 (原始加速度)")
+    print("1. 带通")
+    print("2. 带通 + RMS (缓冲区为 RMS 值，非波形)")
+    mode = input("请选择 [0-2]: ").strip()
+    if mode not in ('0', '1', '2'):
+        print("无效选择")
+        return
+    hpf = lpf = 0
+    if mode != '0':
+        try:
+            hpf = int(input("高通截止 Hz (0 = 旁路，默认 1000): ").strip() or 1000)
+            lpf = int(input("低通截止 Hz (0 = 旁路，默认 8000): ").strip() or 8000)
+        except ValueError:
+            print("输入无效")
+            return
+        if not (0 <= hpf <= 65535 and 0 <= lpf <= 65535) or (hpf and lpf and hpf >= lpf):
+            print("参数超出范围 (需高通 < 低通)")
+            return
+
+    ser = open_serial()
+    if not ser: return
+    try:
+        payload = struct.pack('>BBHH', CFG_SUB_ADP, int(mode), hpf, lpf)
+        ser.write(build_frame(CONFIG['ADDR'], CMD_CONFIG, payload))
+        ack = ser.read(7)
+        if len(ack) == 7 and ack[1] == CMD_CONFIG and ack[3] == 0x4F and ack[4] == 0x4B:
+            print("[成功] ADP 已" + ("关闭" if mode == '0' else f"开启: {hpf} ~ {lpf} Hz") + " (采集已重启)")
+        elif not ack:
+            print("[失败] 无应答 (固件未启用 ADP)")
+        else:
+            print(f"[失败] 响应异常: {ack.hex()}")
+    finally:
+        ser.close()
+
+
+def baud_request(ser, idx):
+    """发送 CMD_BAUD 并解析应答，返回 (idx, state, result)，失败返回 None"""
+    ser.reset_input_buffer()
+    ser.write(build_frame(CONFIG['ADDR'], CMD_BAUD, struct.pack('BBB', idx, 0, 0)))
+    resp = ser.read(8)
+    if len(resp) != 8 or resp[1] != CMD_BAUD or calc_crc16(resp[:-2]) != struct.unpack('<H', resp[-2:])[0]:
+        return None
+    return resp[3], resp[4], resp[5]
+
+
+def task_set_baud():
+    """协商串口波特率: 旧波特率下发切换 -> 新波特率下确认，确认失败时设备自动回落到 9600"""
+    print("\n--- 串口波特率 ---")
+    for i, b in enumerate(BAUD_TABLE):
+        print(f"{i}. {b}")
+    sel = input(f"请选择 [0-{len(BAUD_TABLE) - 1}]: ").strip()
+    if not sel.isdigit() or int(sel) >= len(BAUD_TABLE):
+        print("无效选择")
+        return
+    idx = int(sel)
+
+    ser = open_serial()
+    if not ser: return
+    try:
+        rsp = baud_request(ser, idx)
+        if rsp is None:
+            print("[失败] 无应答，波特率未改变")
+            return
+        if rsp[2] != 0:
+            print(f"[失败] 设备不支持 {BAUD_TABLE[idx]} (当前时钟下误差过大)")
+            return
+
+        # 设备发完应答后切换，这里改用新波特率发确认帧
+        ser.baudrate = BAUD_TABLE[idx]
+        time.sleep(0.05)
+        rsp = baud_request(ser, BAUD_QUERY)
+        if rsp is not None and rsp[0] == idx and rsp[1] == 0:
+            CONFIG['BAUD'] = BAUD_TABLE[idx]
+            print(f"[成功] 波特率已切换为 {CONFIG['BAUD']} 并保存")
+            return
+
+        # 新波特率不通: 等设备试用超时回落，再按 9600 核对
+        print(f"[失败] {BAUD_TABLE[idx]} 下无应答，等待设备回落到 9600 ...")
+        CONFIG['BAUD'] = BAUD_TABLE[0]
+        ser.baudrate = CONFIG['BAUD']
+        time.sleep(BAUD_PROBATION_S + 0.5)
+        rsp = baud_request(ser, BAUD_QUERY)
+        if rsp is not None and rsp[0] == 0:
+            print("设备已回落到 9600")
+        else:
+            print("9600 下仍无应答，请检查接线或用 [6] 手动设置波特率")
+    finally:
+        ser.close()
+
+
+def task_set_trigger():
+    """设置触发条件并布防 (每次设置都会丢弃上一次捕获)"""
+    print("\n--- 触发捕获设置 ---")
+    print("0. 关闭")
+    print("1. 电平: |a - 基线| > 阈值")
+    print("2. 斜率: |a[n] - a[n-1]| > 阈值")
+    mode = input("触发模式 [0-2]: ").strip()
+    if mode not in ('0', '1', '2'):
+        print("无效选择")
+        return
+    axis, thr, pre = 2, 0, 0
+    if mode != '0':
+        try:
+            axis = int(input("触发轴 (0 X / 1 Y / 2 Z，默认 2): ").strip() or 2)
+            thr = int(input("阈值 (mg): ").strip())
+            pre = int(input("预触发采样数 (0~1023，默认 256): ").strip() or 256)
+        except ValueError:
+            print("输入无效")
+            return
+        if axis not in (0, 1, 2) or not (0 < thr <= 65535) or not (0 <= pre < 1024):
+            print("参数超出范围")
+            return
+
+    ser = open_serial()
+    if not ser: return
+    try:
+        payload = struct.pack('>BBBHH', CFG_SUB_TRIGGER, int(mode), axis, thr, pre)
+        ser.write(build_frame(CONFIG['ADDR'], CMD_CONFIG, payload))
+        ack = ser.read(7)
+        if len(ack) == 7 and ack[1] == CMD_CONFIG and ack[3] == 0x4F and ack[4] == 0x4B:
+            print("[成功] 触发已" + ("关闭" if mode == '0' else "布防"))
+        else:
+            print(f"[失败] 响应异常: {ack.hex()}")
+    finally:
+        ser.close()
+
+
+def task_read_trigger():
+    """读取触发状态，已冻结则下载整段捕获"""
+    state_name = {0: '未启用', 1: '布防中', 2: '已触发 (采集触发后数据)', 3: '已冻结'}
+    frame_len = 3 + 20 + 2
+
+    ser = open_serial()
+    if not ser: return
+    try:
+        ser.write(build_frame(CONFIG['ADDR'], CMD_TRIG_INFO, struct.pack('BBB', 0, 0, 0)))
+        resp = ser.read(frame_len)
+        if len(resp) != frame_len or resp[1] != CMD_TRIG_INFO:
+            print(f"触发状态读取失败 (Len={len(resp)})")
+            return
+        if calc_crc16(resp[:-2]) != struct.unpack('<H', resp[-2:])[0]:
+            print("触发状态 CRC 错误")
+            return
+
+        state, mode, axis, flags, pre, length, thr, odr, trig_sample, trig_tick = \
+            struct.unpack('>BBBBHHHHII', resp[3:23])
+        print(f"\n触发状态: {state_name.get(state, '?')}  模式 {mode} 轴 {'XYZ'[axis]} "
+              f"阈值 {thr} LSB, 预触发 {pre}/{length} 点, ODR {odr} Hz")
+        if state != 3:
+            return
+        print(f"  触发采样 #{trig_sample}, tick {trig_tick}, "
+              f"{'数据不连续' if flags & 0x03 else '数据完整'}{' (8位分辨率)' if flags & 0x08 else ''}")
+
+        PTS_PER_PKT = 64
+        total_pkts = length // PTS_PER_PKT
+        expected_len = 4 + PTS_PER_PKT * 4 + 2
+        all_data = []
+        for seq in range(total_pkts):
+            ser.write(build_frame(CONFIG['ADDR'], CMD_TRIG_PACK, struct.pack('BBB', seq, total_pkts, 0)))
+            pkt = ser.read(expected_len)
+            if len(pkt) != expected_len:
+                print(f"\n 包 {seq} 丢失 (Len={len(pkt)})")
+                return
+            all_data.extend(np.frombuffer(pkt[4:-2], dtype='>f4'))
+            print(f"\r 进度: {seq + 1}/{total_pkts}", end='')
+        print()
+
+        if not os.path.exists(CONFIG['SAVE_DIR']):
+            os.makedirs(CONFIG['SAVE_DIR'])
+        t = (np.arange(len(all_data)) - pre) / float(odr)
+        timestamp = datetime.now().strftime("%Y%m%d_%H%M%S")
+        csv_path = f"{CONFIG['SAVE_DIR']}/trig_{timestamp}.csv"
+        pd.DataFrame({'Time_s': t, 'Acceleration_g': all_data}).to_csv(csv_path, index_label="Index")
+        print(f" CSV已保存: {csv_path}")
+
+        plt.figure(figsize=(10, 5))
+        plt.plot(t, all_data, color='#d62728', linewidth=0.8, label=f"{'XYZ'[axis]}-Axis")
+        plt.axvline(0.0, color='k', linestyle='--', linewidth=0.8)
+        plt.title(f"Triggered capture - {timestamp}")
+        plt.xlabel("Time from trigger (s)")
+        plt.grid(True, alpha=0.5)
+        plt.legend()
+        plt.show()
+    finally:
+        ser.close()
+
+
+def lrec_request(ser, sub, payload=b''):
+    """发送 CMD_LREC 子命令，返回状态元组或 None"""
+    frame_len = 3 + 27 + 2
+    ser.write(build_frame(CONFIG['ADDR'], CMD_LREC, struct.pack('B', sub) + payload + b'\x00\x00'))
+    resp = ser.read(frame_len)
+    if len(resp) != frame_len or resp[1] != CMD_LREC:
+        print(f"长记录状态读取失败 (Len={len(resp)})")
+        return None
+    if calc_crc16(resp[:-2]) != struct.unpack('<H', resp[-2:])[0]:
+        print("长记录状态 CRC 错误")
+        return None
+    return struct.unpack('>BBBBBHIIIII', resp[3:30])
+
+
+def task_long_record():
+    """长记录: 整个帧缓冲作为单轴记录，完成后分包下载并释放"""
+    try:
+        axis = int(input("记录轴 (0 X / 1 Y / 2 Z，默认 2): ").strip() or 2)
+        decim = int(input("抽取倍数 (1~64，默认 1): ").strip() or 1)
+        pack8 = int(input("压缩为 8 位? (0 否 / 1 是，默认 0): ").strip() or 0)
+        points = int(input("点数 (0 = 记满): ").strip() or 0)
+    except ValueError:
+        print("输入无效")
+        return
+
+    ser = open_serial()
+    if not ser: return
+    try:
+        st = lrec_request(ser, LREC_START, struct.pack('>BBBI', axis, decim, pack8, points))
+        if not st: return
+        if st[0] not in (1, 2):
+            print("设备拒绝记录请求 (参数无效?)")
+            return
+
+        # 等待记录完成
+        while True:
+            state, _, _, _, flags, odr, target, count, first, t0, t1 = st
+            print(f"\r 记录中: {count}/{target} 点", end='')
+            if state == 3:
+                break
+            if state == 0:
+                print("\n记录被释放")
+                return
+            time.sleep(0.5)
+            st = lrec_request(ser, LREC_QUERY)
+            if not st: return
+        rate = odr / decim
+        print(f"\n记录完成: {count} 点, {rate:.1f} Hz, 时长 {count / rate:.2f}s, "
+              f"{'数据不连续' if flags & 0x03 else '数据完整'}")
+
+        PTS_PER_PKT = 64
+        total_pkts = (count + PTS_PER_PKT - 1) // PTS_PER_PKT
+        expected_len = 6 + PTS_PER_PKT * 4 + 2
+        all_data = []
+        start_time = time.time()
+        for seq in range(total_pkts):
+            ser.write(build_frame(CONFIG['ADDR'], CMD_LREC_PACK, struct.pack('>HB', seq, 0)))
+            pkt = ser.read(expected_len)
+            if len(pkt) != expected_len:
+                print(f"\n 包 {seq} 丢失 (Len={len(pkt)})")
+                return
+            all_data.extend(np.frombuffer(pkt[6:-2], dtype='>f4'))
+            print(f"\r 进度: {seq + 1}/{total_pkts}", end='')
+        all_data = all_data[:count]
+        print(f"\n 读取完成，耗时 {time.time() - start_time:.2f}s")
+
+        if not os.path.exists(CONFIG['SAVE_DIR']):
+            os.makedirs(CONFIG['SAVE_DIR'])
+        t = np.arange(len(all_data)) / rate
+        timestamp = datetime.now().strftime("%Y%m%d_%H%M%S")
+        csv_path = f"{CONFIG['SAVE_DIR']}/lrec_{timestamp}.csv"
+        pd.DataFrame({'Time_s': t, 'Acceleration_g': all_data}).to_csv(csv_path, index_label="Index")
+        print(f" CSV已保存: {csv_path}")
+
+        plt.figure(figsize=(12, 5))
+        plt.plot(t, all_data, color='#2ca02c', linewidth=0.6, label=f"{'XYZ'[axis]}-Axis")
+        plt.title(f"Long record - {timestamp}")
+        plt.xlabel("Time (s)")
+        plt.grid(True, alpha=0.5)
+        plt.legend()
+        plt.show()
+    finally:
+        # 无论成功与否都释放，设备恢复正常采集与分析
+        lrec_request(ser, LREC_RELEASE)
+        ser.close()
+
+
 # ==========================================
 # [功能] 5. OTA 固件升级
 # ==========================================
@@ -501,6 +1134,18 @@ def main():
         print("4. [工具] 扫描设备 & 读取 UID")
         print("5. [升级] OTA 固件升级")
         print("6. [参数] 修改串口 & 目标地址")
+        print("7. [数据] 读取频谱峰值表")
+        print("8. [数据] 读取 Welch 功率谱")
+        print("9. [设置] 设置 FFT 窗函数")
+        print("a. [数据] 读取采集完整性 & 实测 ODR")
+        print("b. [设置] 设置采集分辨率 (8/16 位)")
+        print("c. [设置] 触发捕获设置 & 布防")
+        print("d. [数据] 读取触发捕获")
+        print("e. [数据] 长记录 (整块缓冲单轴记录)")
+        print("f. [设置] 传感器内滤波 (ADP)")
+        print("g. [设置] 协商串口波特率")
+        print("h. [数据] 读取串口发送队列统计")
+        print("i. [数据] 读取 X/Y 轴频谱主峰")
         print("q. [退出] 退出程序")
         print("=" * 40)
 
@@ -523,6 +1168,32 @@ def main():
             if b: CONFIG['BAUD'] = int(b)
             a = input(f"输入目标地址Hex (默认 {CONFIG['ADDR']:02X}): ").strip()
             if a: CONFIG['ADDR'] = int(a, 16)
+            e = input(f"波形编码 0 F32 1 I16 2 DELTA (默认 {CONFIG['WAVE_ENC']}): ").strip()
+            if e in ('0', '1', '2'): CONFIG['WAVE_ENC'] = int(e)
+        elif choice == '7':
+            task_read_peaks()
+        elif choice == '8':
+            task_read_psd()
+        elif choice == '9':
+            task_set_window()
+        elif choice == 'a':
+            task_read_acq_info()
+        elif choice == 'b':
+            task_set_resolution()
+        elif choice == 'c':
+            task_set_trigger()
+        elif choice == 'd':
+            task_read_trigger()
+        elif choice == 'e':
+            task_long_record()
+        elif choice == 'f':
+            task_set_adp()
+        elif choice == 'g':
+            task_set_baud()
+        elif choice == 'h':
+            task_read_tx_stats()
+        elif choice == 'i':
+            task_read_xy_peaks()
         elif choice == 'q':
             print("Bye! ")
             break